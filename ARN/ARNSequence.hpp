@@ -98,6 +98,20 @@ int* computeDistanceMatrix(const vector<ARNSeq>& sequences,
 int writeGraphDOT(const vector<ARNSeq>& sequences, int* distanceMatrix, 
                   int epsilon, const string& outputFile);
 
+/**
+ * @brief Écrit le graphe de writeGraphDOT au format binaire .gcsr
+ *        (Floyd/GrapheBinaire.hpp) : en-tête, débuts CSR, voisins, poids et
+ *        noms des sommets, relus par mmap sans copie
+ * 
+ * @param sequences Vecteur de séquences d'ARN
+ * @param distanceMatrix Matrice de distances entre les séquences
+ * @param epsilon Seuil de distance pour créer une arête
+ * @param outputFile Fichier de sortie (.gcsr)
+ * @return int 0 si succès, -1 en cas d'erreur
+ */
+int writeGraphCSR(const vector<ARNSeq>& sequences, int* distanceMatrix,
+                  int epsilon, const string& outputFile);
+
 /**
  * @brief Affiche une séquence d'ARN
  * 
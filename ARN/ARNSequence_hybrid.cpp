@@ -5,6 +5,7 @@
  */
 
 #include "ARNSequence_hybrid.hpp"
+#include "../Floyd/GrapheBinaire.hpp"
 #include <fstream>
 #include <algorithm>
 #include <cstring>
@@ -260,6 +261,39 @@ int writeGraphDOT(const vector<ARNSeq>& sequences, int* distanceMatrix,
     return 0;
 }
 
+/**
+ * @brief Écrit le même graphe que writeGraphDOT au format binaire .gcsr
+ *        (arcs dans les deux sens, sommets nommés seq0, seq1, ...), relu
+ *        par projection mémoire sans analyse de texte
+ */
+int writeGraphCSR(const vector<ARNSeq>& sequences, int* distanceMatrix,
+                  int epsilon, const string& outputFile) {
+    int n = sequences.size();
+    vector<long> debut(n + 1, 0);
+    vector<int> voisins, poids;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            // Même poids que l'arête i -- j du .dot (triangle supérieur)
+            int dist = distanceMatrix[(long)min(i, j) * n + max(i, j)];
+            if (i != j && dist < epsilon) {
+                voisins.push_back(j);
+                poids.push_back(dist);
+            }
+        }
+        debut[i+1] = voisins.size();
+    }
+    vector<string> noms(n);
+    for (int i = 0; i < n; i++) noms[i] = "seq" + to_string(i);
+
+    if (ecrireCSR(outputFile.c_str(), n, debut.data(), voisins.data(), poids.data(), noms) != 0) {
+        cerr << "Erreur : impossible d'écrire le fichier " << outputFile << endl;
+        return -1;
+    }
+    cout << "Graphe écrit dans " << outputFile << endl;
+    cout << "  Nœuds : " << n << ", Arêtes : " << voisins.size() / 2 << endl;
+    return 0;
+}
+
 void printARNSeq(const ARNSeq& seq) {
     cout << "ID: " << seq.id << " | Label: " << seq.label 
          << " | Séquence: " << seq.sequence.substr(0, 50);
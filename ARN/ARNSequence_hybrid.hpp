@@ -37,6 +37,8 @@ int* computeDistanceMatrix_Hybrid(const vector<ARNSeq>& sequences,
 
 int writeGraphDOT(const vector<ARNSeq>& sequences, int* distanceMatrix, 
                   int epsilon, const string& outputFile);
+int writeGraphCSR(const vector<ARNSeq>& sequences, int* distanceMatrix,
+                  int epsilon, const string& outputFile);
 
 void printARNSeq(const ARNSeq& seq);
 void printDistanceMatrix(int* distanceMatrix, int n);
@@ -26,7 +26,7 @@ int main(int argc, char* argv[]) {
     if(argc < 4) {
         if(pid == 0) {
             cerr << "Usage: " << argv[0] 
-                 << " <fichier_fasta> <epsilon> <k_clusters> [output_dot]" << endl;
+                 << " <fichier_fasta> <epsilon> <k_clusters> [output.dot|output.gcsr]" << endl;
         }
         MPI_Finalize();
         return EXIT_FAILURE;
@@ -95,42 +95,22 @@ int main(int argc, char* argv[]) {
         cout << "Temps calcul distances : " << (t_dist_end - t_dist_start) << " sec" << endl;
     }
 
-    // ===== ÉTAPE 2 : Vérifications pour Floyd =====
-    int p_sqrt = static_cast<int>(sqrt(nprocs));
-    if(p_sqrt * p_sqrt != nprocs) {
-        if(pid == 0) {
-            cerr << "Erreur : nprocs doit être un carré parfait (1,4,9,16,...)" << endl;
-        }
-        MPI_Finalize();
-        return EXIT_FAILURE;
-    }
-    
-    // CORRECTION 1 : Broadcaster nbSeq D'ABORD
+    // ===== ÉTAPE 2 : Distribution pour Floyd =====
     MPI_Bcast(&nbSeq, 1, MPI_INT, 0, MPI_COMM_WORLD);
     
-    // CORRECTION 2 : Calculer et broadcaster block_size CORRECTEMENT
-    int block_size = 0;
-    if(pid == 0) {
-        if(nbSeq % p_sqrt != 0) {
-            cerr << "Erreur : nbSeq (" << nbSeq << ") doit être divisible par sqrt(nprocs) (" 
-                 << p_sqrt << ")" << endl;
-            MPI_Finalize();
-            return EXIT_FAILURE;
-        }
-        block_size = nbSeq / p_sqrt;
-    }
-    MPI_Bcast(&block_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
-    
-    // Maintenant on peut allouer avec block_size correct
-    int* D_local = new int[block_size * block_size];
+    // Grille et taille de bloc automatiques : tout nombre de processus convient
+    Distribution dist = creerDistribution(nbSeq, 0, 0, 0);
+    int* D_local = new int[tailleLocale(dist)];
 
     // ===== ÉTAPE 3 : Floyd-Warshall =====
     if(pid == 0) cout << "\nCalcul Floyd-Warshall..." << endl;
     
     double t_floyd_start = MPI_Wtime();
     
-    decouperMatrice(distanceMatrix, D_local, nbSeq, block_size, p_sqrt, 0, pid);
-    int* D_global = floydBlocsHybrid(D_local, nbSeq, p_sqrt, pid, 0);
+    decouperMatrice(distanceMatrix, D_local, dist, 0);
+    delete[] distanceMatrix; // déjà distribuée : libère n² entiers sur le root
+    distanceMatrix = nullptr;
+    int* D_global = floydBlocsHybrid(D_local, dist, 0, 0);
     
     double t_floyd_end = MPI_Wtime();
 
@@ -169,20 +149,23 @@ int main(int argc, char* argv[]) {
         for(auto c : cluster_counts) cout << c << " ";
         cout << endl;
 
-        // Écriture du graphe DOT
+        // Écriture du graphe : DOT, ou binaire .gcsr selon l'extension
         cout << "\nÉcriture graphe..." << endl;
-        if(writeGraphDOT(sequences, D_global, epsilon, outputFile) == 0) {
+        bool binaire = outputFile.size() > 5 && outputFile.compare(outputFile.size() - 5, 5, ".gcsr") == 0;
+        int ecrit = binaire ? writeGraphCSR(sequences, D_global, epsilon, outputFile)
+                            : writeGraphDOT(sequences, D_global, epsilon, outputFile);
+        if(ecrit == 0) {
             cout << "Graphe écrit : " << outputFile << endl;
         }
         
         double t_total_end = MPI_Wtime();
         cout << "\n=== TEMPS TOTAL : " << (t_total_end - t_total_start) << " sec ===" << endl;
 
-        delete[] distanceMatrix;
         delete[] D_global;
     }
 
     delete[] D_local;
+    libererDistribution(dist);
     MPI_Finalize();
     return 0;
 }
\ No newline at end of file
@@ -47,7 +47,7 @@ int main(int argc, char* argv[]) {
     if(argc < 4) {
         if(pid == 0) {
             cerr << "Usage: " << argv[0] 
-                 << " <fasta> <epsilon> <k> [output.dot] [omp_threads]" << endl;
+                 << " <fasta> <epsilon> <k> [output.dot|output.gcsr] [omp_threads]" << endl;
         }
         MPI_Finalize();
         return EXIT_FAILURE;
@@ -114,39 +114,19 @@ int main(int argc, char* argv[]) {
         cout << "      Temps: " << (t_dist_end - t_dist_start) << " sec" << endl;
     }
     
-    // ===== ÉTAPE 3 : Vérifications Floyd =====
-    int p_sqrt = static_cast<int>(sqrt(nprocs));
-    
-    if(p_sqrt * p_sqrt != nprocs) {
-        if(pid == 0) {
-            cerr << "ERREUR: nprocs doit être carré parfait (1,4,9,16...)" << endl;
-        }
-        MPI_Finalize();
-        return EXIT_FAILURE;
-    }
-    
-    int block_size = 0;
-    if(pid == 0) {
-        if(nbSeq % p_sqrt != 0) {
-            cerr << "ERREUR: nbSeq (" << nbSeq << ") divisible par sqrt(nprocs) (" 
-                 << p_sqrt << ")" << endl;
-            MPI_Finalize();
-            return EXIT_FAILURE;
-        }
-        block_size = nbSeq / p_sqrt;
-    }
-    
-    // CORRECTION CRITIQUE
-    MPI_Bcast(&block_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
-    
-    int* D_local = new int[block_size * block_size];
+    // ===== ÉTAPE 3 : Distribution Floyd =====
+    // Grille pr x pc et blocs choisis automatiquement (bloc-cyclique)
+    Distribution dist = creerDistribution(nbSeq, 0, 0, 0);
+    int* D_local = new int[tailleLocale(dist)];
     
     // ===== ÉTAPE 4 : Floyd-Warshall =====
     if(pid == 0) cout << "\n[3/5] Floyd-Warshall..." << endl;
     
     double t_floyd_start = MPI_Wtime();
-    decouperMatrice(distanceMatrix, D_local, nbSeq, block_size, p_sqrt, 0, pid);
-    int* D_global = floydBlocsHybrid(D_local, nbSeq, p_sqrt, pid, 0);
+    decouperMatrice(distanceMatrix, D_local, dist, 0);
+    delete[] distanceMatrix; // déjà distribuée : libère n² entiers sur le root
+    distanceMatrix = nullptr;
+    int* D_global = floydBlocsHybrid(D_local, dist, 0, 0);
     double t_floyd_end = MPI_Wtime();
     
     if(pid == 0) {
@@ -181,9 +161,12 @@ int main(int argc, char* argv[]) {
         for(auto c : cluster_counts) cout << c << " ";
         cout << endl;
         
-        // ===== ÉTAPE 6 : Graphe DOT =====
+        // ===== ÉTAPE 6 : Graphe DOT ou binaire .gcsr (selon l'extension) =====
         cout << "\n[5/5] Génération graphe..." << endl;
-        if(writeGraphDOT(sequences, D_global, epsilon, outputFile) == 0) {
+        bool binaire = outputFile.size() > 5 && outputFile.compare(outputFile.size() - 5, 5, ".gcsr") == 0;
+        int ecrit = binaire ? writeGraphCSR(sequences, D_global, epsilon, outputFile)
+                            : writeGraphDOT(sequences, D_global, epsilon, outputFile);
+        if(ecrit == 0) {
             cout << "      ✅ Graphe: " << outputFile << endl;
         }
         
@@ -193,11 +176,11 @@ int main(int argc, char* argv[]) {
         cout << "  TEMPS TOTAL: " << (t_total_end - t_total_start) << " sec" << endl;
         cout << "=====================================" << endl;
         
-        delete[] distanceMatrix;
         delete[] D_global;
     }
     
     delete[] D_local;
+    libererDistribution(dist);
     MPI_Finalize();
     return 0;
 }
@@ -0,0 +1,314 @@
+#include "Composantes.hpp"
+#include "FoydPar.hpp"
+
+#include <omp.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <queue>
+
+using namespace std;
+
+/* Racine de u, avec compression par moitiés : u est raccroché à son
+ * grand-parent. Les parents ne désignent jamais que des ancêtres, ce qui
+ * rend la compression sûre pendant les réunions concurrentes. */
+static int racine(vector<atomic<int> >& parent, int u) {
+    while (true) {
+        int p = parent[u].load(memory_order_relaxed);
+        if (p == u) return u;
+        int gp = parent[p].load(memory_order_relaxed);
+        if (gp == p) return p;
+        parent[u].compare_exchange_weak(p, gp, memory_order_relaxed);
+        u = gp;
+    }
+}
+
+/* Réunit les ensembles de u et v : la racine de plus grand numéro est
+ * accrochée à l'autre, seulement si elle est encore racine (sinon on
+ * recommence depuis les nouvelles racines) */
+static void unir(vector<atomic<int> >& parent, int u, int v) {
+    while (true) {
+        u = racine(parent, u);
+        v = racine(parent, v);
+        if (u == v) return;
+        if (u < v) swap(u, v);
+        int attendu = u;
+        if (parent[u].compare_exchange_strong(attendu, v, memory_order_relaxed)) return;
+    }
+}
+
+Decomposition decomposerComposantes(const GrapheCSR& g) {
+    int n = g.n;
+    vector<atomic<int> > parent(n);
+    #pragma omp parallel for
+    for (int u = 0; u < n; u++)
+        parent[u].store(u, memory_order_relaxed);
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int u = 0; u < n; u++)
+        for (long a = g.debut[u]; a < g.debut[u+1]; a++)
+            unir(parent, u, g.voisins[a]);
+
+    vector<int> etiquette(n);
+    #pragma omp parallel for
+    for (int u = 0; u < n; u++)
+        etiquette[u] = racine(parent, u);
+
+    // Composantes par taille décroissante (à taille égale, par plus petit sommet)
+    vector<int> taille(n, 0), racines;
+    for (int u = 0; u < n; u++) {
+        if (etiquette[u] == u) racines.push_back(u);
+        taille[etiquette[u]]++;
+    }
+    stable_sort(racines.begin(), racines.end(),
+                [&taille](int a, int b) { return taille[a] > taille[b]; });
+
+    Decomposition dec;
+    dec.n = n;
+    dec.nb_composantes = (int)racines.size();
+    dec.debut.assign(racines.size() + 1, 0);
+    vector<int> position(n);  // prochaine place libre de chaque composante, par racine
+    for (size_t c = 0; c < racines.size(); c++) {
+        position[racines[c]] = dec.debut[c];
+        dec.debut[c+1] = dec.debut[c] + taille[racines[c]];
+    }
+    dec.ordre.resize(n);
+    for (int u = 0; u < n; u++)
+        dec.ordre[position[etiquette[u]]++] = u;
+    return dec;
+}
+
+/* Arêtes de la composante c en numérotation locale (rang[u] = place de u
+ * dans sa composante), chaque arête une fois (le CSR est symétrique) */
+static void aretesComposante(const GrapheCSR& g, const Decomposition& dec, const vector<int>& rang,
+                             int c, vector<int>* aretes) {
+    for (int x = dec.debut[c]; x < dec.debut[c+1]; x++) {
+        int u = dec.ordre[x];
+        for (long a = g.debut[u]; a < g.debut[u+1]; a++) {
+            int v = g.voisins[a];
+            if (v < u) continue;
+            aretes->push_back(rang[u]);
+            aretes->push_back(rang[v]);
+            aretes->push_back(g.poids[a]);
+        }
+    }
+}
+
+/* Ajoute len distances au résumé */
+template<typename T>
+static void resumer(const T* v, int len, ResumeDistances* r) {
+    for (int j = 0; j < len; j++) {
+        if (v[j] >= Poids<T>::infini()) r->non_reliees++;
+        else { r->somme += (long long)v[j]; r->diametre = max(r->diametre, (long long)v[j]); }
+    }
+}
+
+/* Recopie la matrice M d'une composante de t sommets (sommets[0..t-1] dans
+ * la numérotation d'origine) dans la matrice n x n D */
+template<typename T>
+static void placer(T* D, int n, const T* M, int t, const int* sommets) {
+    #pragma omp parallel for
+    for (int i = 0; i < t; i++) {
+        T* Di = D + (long)sommets[i] * n;
+        for (int j = 0; j < t; j++)
+            Di[sommets[j]] = M[(long)i*t + j];
+    }
+}
+
+template<typename T>
+T* apspComposantes(const Decomposition& dec, const GrapheCSR& g, int nb, int pr, int pc,
+                   int root, int num_threads, bool rassembler, ResumeDistances* resume,
+                   BilanComposantes* bilan) {
+    int pid, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    if (num_threads > 0)
+        omp_set_num_threads(num_threads);
+
+    // Tailles des composantes, connues de tous les processus
+    int k = dec.nb_composantes;
+    MPI_Bcast(&k, 1, MPI_INT, root, MPI_COMM_WORLD);
+    vector<int> debut(k + 1);
+    if (pid == root) debut = dec.debut;
+    MPI_Bcast(debut.data(), k + 1, MPI_INT, root, MPI_COMM_WORLD);
+    int n = debut[k];
+    auto taille = [&debut](int c) { return debut[c+1] - debut[c]; };
+
+    vector<int> rang;
+    if (pid == root) {
+        rang.resize(n);
+        for (int c = 0; c < k; c++)
+            for (int x = debut[c]; x < debut[c+1]; x++)
+                rang[dec.ordre[x]] = x - debut[c];
+    }
+    T* D = nullptr;
+    if (pid == root && rassembler) {
+        D = new T[(long)n * n];
+        #pragma omp parallel for
+        for (long x = 0; x < (long)n * n; x++)
+            D[x] = Poids<T>::infini();
+    }
+    ResumeDistances r = {0, 0, 0};
+
+    // Grandes composantes (en tête, tailles décroissantes) : toute la grille
+    int grille = 0;
+    while (grille < k && taille(grille) >= FLOYD_COMPOSANTE_GRILLE)
+        grille++;
+    for (int c = 0; c < grille; c++) {
+        int t = taille(c);
+        vector<int> aretes;
+        if (pid == root) aretesComposante(g, dec, rang, c, &aretes);
+        Distribution dist = creerDistribution(t, nb, pr, pc);
+        T* X_local = new T[tailleLocale(dist)];
+        distribuerAretes(aretes.data(), (long)aretes.size() / 3, X_local, dist, root);
+        vector<int>().swap(aretes);
+        floydBlocsLocal(X_local, dist, num_threads);
+        if (rassembler) {
+            T* M = rassemblerMatrice(X_local, dist, root);
+            if (pid == root) placer(D, n, M, t, &dec.ordre[debut[c]]);
+            delete[] M;
+        } else {
+            for (int li = 0; li < dist.lignes; li++)
+                for (int lj = 0; lj < dist.colonnes; lj++) {
+                    int i0 = blocGlobalLigne(dist, li) * dist.nb, j0 = blocGlobalColonne(dist, lj) * dist.nb;
+                    const T* B = blocLocal(X_local, dist, li, lj);
+                    for (int i = 0; i < dist.nb && i0+i < t; i++)
+                        resumer(B + (long)i*dist.nb, min(dist.nb, t - j0), &r);
+                }
+        }
+        delete[] X_local;
+        libererDistribution(dist);
+    }
+
+    // Petites composantes : la plus coûteuse (t³) d'abord, au processus le
+    // moins chargé ; même répartition calculée par tous les processus
+    vector<int> proc(k, -1);
+    priority_queue<pair<double,int>, vector<pair<double,int> >, greater<pair<double,int> > > charges;
+    for (int p = 0; p < nprocs; p++) charges.push(make_pair(0.0, p));
+    for (int c = grille; c < k; c++) {
+        pair<double,int> x = charges.top();
+        charges.pop();
+        proc[c] = x.second;
+        x.first += (double)taille(c) * taille(c) * taille(c);
+        charges.push(x);
+    }
+    vector<int> miennes;
+    for (int c = grille; c < k; c++)
+        if (proc[c] == pid) miennes.push_back(c);
+
+    // Arêtes renumérotées de chaque composante ([m, puis m triplets]),
+    // regroupées par processus destinataire
+    vector<int> compte(nprocs, 0), depl(nprocs, 0), envoi;
+    if (pid == root) {
+        vector<vector<int> > par_proc(nprocs);
+        for (int c = grille; c < k; c++) {
+            vector<int>& v = par_proc[proc[c]];
+            size_t tete = v.size();
+            v.push_back(0);
+            aretesComposante(g, dec, rang, c, &v);
+            v[tete] = (int)(v.size() - tete - 1) / 3;
+        }
+        for (int p = 0; p < nprocs; p++) {
+            compte[p] = (int)par_proc[p].size();
+            if (p > 0) depl[p] = depl[p-1] + compte[p-1];
+        }
+        envoi.reserve(depl[nprocs-1] + compte[nprocs-1]);
+        for (int p = 0; p < nprocs; p++)
+            envoi.insert(envoi.end(), par_proc[p].begin(), par_proc[p].end());
+    }
+    int nb_recus;
+    MPI_Scatter(compte.data(), 1, MPI_INT, &nb_recus, 1, MPI_INT, root, MPI_COMM_WORLD);
+    vector<int> recus(nb_recus);
+    MPI_Scatterv(envoi.data(), compte.data(), depl.data(), MPI_INT,
+                 recus.data(), nb_recus, MPI_INT, root, MPI_COMM_WORLD);
+    vector<int>().swap(envoi);
+
+    // Chaque composante entière sur un thread : matrices à la suite dans
+    // resultats (rassemblement) ou temporaires (résumé seul)
+    int nm = (int)miennes.size();
+    vector<long> pos_aretes(nm), pos_resultat(nm + 1, 0);
+    for (int x = 0, a = 0; x < nm; x++) {
+        pos_aretes[x] = a;
+        a += 1 + 3*recus[a];
+        pos_resultat[x+1] = pos_resultat[x] + (long)taille(miennes[x]) * taille(miennes[x]);
+    }
+    T* resultats = rassembler ? new T[pos_resultat[nm]] : nullptr;
+    long long somme = 0, non_reliees = 0, diametre = 0;
+    #pragma omp parallel for schedule(dynamic) reduction(+:somme,non_reliees) reduction(max:diametre)
+    for (int x = 0; x < nm; x++) {
+        int t = taille(miennes[x]);
+        T* M = rassembler ? resultats + pos_resultat[x] : new T[(long)t * t];
+        for (long y = 0; y < (long)t * t; y++)
+            M[y] = (y % (t + 1) == 0) ? 0 : Poids<T>::infini();
+        // Même convention que construireLocale : la dernière occurrence
+        // l'emporte, un poids nul signifie "pas d'arête"
+        const int* a = &recus[pos_aretes[x]];
+        for (int e = 0; e < a[0]; e++) {
+            int u = a[1 + 3*e], v = a[2 + 3*e], w = a[3 + 3*e];
+            if (u == v) continue;
+            M[(long)u*t + v] = M[(long)v*t + u] = (w == 0) ? Poids<T>::infini() : (T)w;
+        }
+        floydTuiles(M, t, nullptr, FLOYD_TUILE);
+        if (!rassembler) {
+            ResumeDistances rc = {0, 0, 0};
+            resumer(M, t * t, &rc);
+            somme += rc.somme;
+            non_reliees += rc.non_reliees;
+            diametre = max(diametre, rc.diametre);
+            delete[] M;
+        }
+    }
+    r.somme += somme;
+    r.non_reliees += non_reliees;
+    r.diametre = max(r.diametre, diametre);
+
+    if (rassembler) {
+        // Rassemblement des matrices des petites composantes, placées par le
+        // root dans l'ordre où chaque processus les a calculées
+        vector<int> nb_valeurs(nprocs, 0), depl_valeurs(nprocs, 0);
+        for (int c = grille; c < k; c++)
+            nb_valeurs[proc[c]] += taille(c) * taille(c);
+        for (int p = 1; p < nprocs; p++)
+            depl_valeurs[p] = depl_valeurs[p-1] + nb_valeurs[p-1];
+        T* tous = nullptr;
+        if (pid == root) tous = new T[(long)depl_valeurs[nprocs-1] + nb_valeurs[nprocs-1]];
+        MPI_Gatherv(resultats, (int)pos_resultat[nm], typeMPI<T>(), tous, nb_valeurs.data(),
+                    depl_valeurs.data(), typeMPI<T>(), root, MPI_COMM_WORLD);
+        if (pid == root) {
+            vector<long> lu(depl_valeurs.begin(), depl_valeurs.end());
+            for (int c = grille; c < k; c++) {
+                int t = taille(c);
+                placer(D, n, tous + lu[proc[c]], t, &dec.ordre[debut[c]]);
+                lu[proc[c]] += (long)t * t;
+            }
+        }
+        delete[] tous;
+        delete[] resultats;
+    }
+
+    // Paires entre composantes : jamais calculées, non reliées
+    if (pid == root) {
+        long long dans_composantes = 0;
+        double travail = 0;
+        for (int c = 0; c < k; c++) {
+            dans_composantes += (long long)taille(c) * taille(c);
+            travail += (double)taille(c) * taille(c) * taille(c);
+        }
+        r.non_reliees += (long long)n * n - dans_composantes;
+        if (bilan) {
+            bilan->sur_grille = grille;
+            bilan->regroupees = k - grille;
+            bilan->travail = n > 0 ? travail / ((double)n * n * n) : 0;
+        }
+    }
+    if (resume) *resume = r;
+    return D;
+}
+
+/* Instanciations pour les types de poids de Poids.hpp */
+#define INSTANCIER_COMPOSANTES(T) \
+    template T* apspComposantes<T>(const Decomposition&, const GrapheCSR&, int, int, int, int, int, \
+                                   bool, ResumeDistances*, BilanComposantes*);
+INSTANCIER_COMPOSANTES(int16_t)
+INSTANCIER_COMPOSANTES(int32_t)
+INSTANCIER_COMPOSANTES(int64_t)
+INSTANCIER_COMPOSANTES(float)
@@ -0,0 +1,93 @@
+#ifndef COMPOSANTES_HPP
+#define COMPOSANTES_HPP
+
+#include <mpi.h>
+#include <vector>
+#include "Dijkstra.hpp"
+
+using namespace std;
+
+/**
+ * @brief Taille à partir de laquelle une composante connexe est résolue par
+ *        Floyd par blocs sur toute la grille ; les plus petites sont
+ *        résolues entières sur un seul processus (modifiable à la
+ *        compilation : -DFLOYD_COMPOSANTE_GRILLE=1024)
+ */
+#ifndef FLOYD_COMPOSANTE_GRILLE
+#define FLOYD_COMPOSANTE_GRILLE 512
+#endif
+
+/**
+ * @brief Composantes connexes d'un graphe non orienté, sommets renumérotés
+ *        pour que chaque composante soit contiguë : la composante c est
+ *        formée des sommets ordre[debut[c] .. debut[c+1]-1], les composantes
+ *        étant rangées par taille décroissante.
+ */
+struct Decomposition {
+    int n;                  /**< Nombre de sommets */
+    int nb_composantes;     /**< Nombre de composantes */
+    vector<int> ordre;      /**< Sommets rangés composante par composante */
+    vector<int> debut;      /**< nb_composantes + 1 débuts dans ordre */
+};
+
+/**
+ * @brief Composantes connexes par union-find parallèle (OpenMP) : chaque
+ *        arc réunit ses deux extrémités, la racine de plus grand numéro
+ *        étant accrochée à l'autre par compare-and-swap, avec compression
+ *        des chemins par moitiés. O(m α(n)) sans verrou.
+ */
+Decomposition decomposerComposantes(const GrapheCSR& g);
+
+/**
+ * @brief Somme des distances finies, paires non reliées et plus grande
+ *        distance finie (les trois champs du résumé de main)
+ */
+struct ResumeDistances {
+    long long somme;
+    long long non_reliees;
+    long long diametre;
+};
+
+/**
+ * @brief Répartition du calcul par composantes (pour l'affichage)
+ */
+struct BilanComposantes {
+    int sur_grille;         /**< Composantes résolues sur toute la grille */
+    int regroupees;         /**< Composantes résolues sur un seul processus */
+    double travail;         /**< Σ c³ / n³ : part du travail de Floyd sur tout le graphe */
+};
+
+/**
+ * @brief Plus courts chemins (min,+) composante par composante (opération
+ *        collective) : les paires de composantes différentes sont à
+ *        l'infini sans calcul, soit Σ c³ au lieu de n³.
+ *
+ * Les composantes d'au moins FLOYD_COMPOSANTE_GRILLE sommets sont
+ * résolues l'une après l'autre sur toute la grille (distribuerAretes puis
+ * floydBlocsLocal sur une distribution de leur taille). Les autres sont
+ * réparties entre les processus (la plus coûteuse d'abord, au processus le
+ * moins chargé), qui les résolvent entières avec floydTuiles, une
+ * composante par thread. Le root envoie à chacun les arêtes renumérotées
+ * de ses composantes (MPI_Scatterv).
+ *
+ * @param dec Décomposition (significative sur root uniquement)
+ * @param g Graphe (significatif sur root uniquement)
+ * @param nb Taille de bloc des composantes sur la grille (0 = automatique)
+ * @param pr Lignes de la grille (0 = automatique)
+ * @param pc Colonnes de la grille (0 = automatique)
+ * @param root Processus racine
+ * @param num_threads Nombre de threads OpenMP (0 = automatique)
+ * @param rassembler Rassembler la matrice n x n sur le root, dans la
+ *        numérotation d'origine
+ * @param resume (sortie, si !rassembler) Contribution du processus au
+ *        résumé des distances ; les paires entre composantes sont comptées
+ *        par le root
+ * @param bilan (sortie, root) Répartition du calcul (nullptr si inutile)
+ * @return T* Matrice n x n sur le root si rassembler, nullptr sinon
+ */
+template<typename T>
+T* apspComposantes(const Decomposition& dec, const GrapheCSR& g, int nb, int pr, int pc,
+                   int root, int num_threads, bool rassembler, ResumeDistances* resume,
+                   BilanComposantes* bilan = nullptr);
+
+#endif
@@ -0,0 +1,231 @@
+#include "Dijkstra.hpp"
+
+#include <omp.h>
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+GrapheCSR csrDepuisAretes(int n, const int* aretes, long nb_aretes) {
+    // Arcs orientés dans l'ordre du fichier : un tri stable par (u, v)
+    // place la dernière occurrence de chaque arc en fin de groupe
+    struct Arc { int u, v, w; };
+    vector<Arc> arcs;
+    arcs.reserve(2*nb_aretes);
+    for (long e = 0; e < nb_aretes; e++) {
+        int u = aretes[3*e], v = aretes[3*e+1], w = aretes[3*e+2];
+        if (u == v) continue;
+        arcs.push_back({u, v, w});
+        arcs.push_back({v, u, w});
+    }
+    stable_sort(arcs.begin(), arcs.end(), [](const Arc& a, const Arc& b) {
+        return a.u != b.u ? a.u < b.u : a.v < b.v;
+    });
+
+    GrapheCSR g;
+    g.n = n;
+    g.debut.assign(n+1, 0);
+    for (size_t a = 0; a < arcs.size(); a++) {
+        bool dernier = (a+1 == arcs.size() || arcs[a+1].u != arcs[a].u || arcs[a+1].v != arcs[a].v);
+        if (!dernier || arcs[a].w == 0) continue;
+        g.voisins.push_back(arcs[a].v);
+        g.poids.push_back(arcs[a].w);
+        g.debut[arcs[a].u + 1]++;
+    }
+    for (int u = 0; u < n; u++) g.debut[u+1] += g.debut[u];
+    return g;
+}
+
+GrapheCSR csrDepuisMatrice(int n, const int* mat_adjacence) {
+    GrapheCSR g;
+    g.n = n;
+    g.debut.assign(n+1, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++)
+            if (i != j && mat_adjacence[(long)i*n + j] != 0) {
+                g.voisins.push_back(j);
+                g.poids.push_back(mat_adjacence[(long)i*n + j]);
+            }
+        g.debut[i+1] = g.voisins.size();
+    }
+    return g;
+}
+
+GrapheCSR csrDepuisVue(const VueCSR& vue) {
+    if (!vue.non_oriente) {
+        vector<int> aretes;
+        aretes.reserve(3*vue.m);
+        for (int u = 0; u < vue.n; u++)
+            for (int64_t a = vue.debut[u]; a < vue.debut[u+1]; a++) {
+                aretes.push_back(u);
+                aretes.push_back(vue.voisins[a]);
+                aretes.push_back(vue.poids[a]);
+            }
+        return csrDepuisAretes(vue.n, aretes.data(), vue.m);
+    }
+    GrapheCSR g;
+    g.n = vue.n;
+    g.debut.assign(vue.n + 1, 0);
+    g.voisins.reserve(vue.m);
+    g.poids.reserve(vue.m);
+    for (int u = 0; u < vue.n; u++) {
+        for (int64_t a = vue.debut[u]; a < vue.debut[u+1]; a++)
+            if (vue.voisins[a] != u && vue.poids[a] != 0) {
+                g.voisins.push_back(vue.voisins[a]);
+                g.poids.push_back(vue.poids[a]);
+            }
+        g.debut[u+1] = g.voisins.size();
+    }
+    return g;
+}
+
+void diffuserCSR(GrapheCSR& g, int root, MPI_Comm comm) {
+    long tailles[2] = {g.n, (long)g.voisins.size()};
+    MPI_Bcast(tailles, 2, MPI_LONG, root, comm);
+    g.n = (int)tailles[0];
+    g.debut.resize(g.n + 1);
+    g.voisins.resize(tailles[1]);
+    g.poids.resize(tailles[1]);
+    MPI_Bcast(g.debut.data(), g.n + 1, MPI_LONG, root, comm);
+    MPI_Bcast(g.voisins.data(), (int)tailles[1], MPI_INT, root, comm);
+    MPI_Bcast(g.poids.data(), (int)tailles[1], MPI_INT, root, comm);
+}
+
+bool poidsNegatifs(const GrapheCSR& g) {
+    for (int w : g.poids)
+        if (w < 0) return true;
+    return false;
+}
+
+bool grapheCreux(const GrapheCSR& g) {
+    if (g.n <= 1 || poidsNegatifs(g)) return false;
+    return (double)g.voisins.size() < FLOYD_DENSITE_CREUX * (double)g.n * g.n;
+}
+
+/**
+ * @brief Tas radix (monotone) pour clés entières : les clés extraites ne
+ *        décroissent jamais, ce qui est le cas de Dijkstra à poids positifs.
+ *        Le seau i contient les clés dont le bit de poids fort qui diffère
+ *        de la dernière clé extraite est le bit i-1 ; chaque élément
+ *        descend au plus 32 fois de seau, d'où un coût amorti O(log C).
+ */
+struct TasRadix {
+    vector<pair<uint32_t,int>> seaux[33];
+    uint32_t dernier;
+    long taille;
+
+    void vider() {
+        for (auto& s : seaux) s.clear();
+        dernier = 0;
+        taille = 0;
+    }
+
+    static int indice(uint32_t cle, uint32_t ref) {
+        return cle == ref ? 0 : 32 - __builtin_clz(cle ^ ref);
+    }
+
+    void inserer(uint32_t cle, int v) {
+        seaux[indice(cle, dernier)].push_back({cle, v});
+        taille++;
+    }
+
+    pair<uint32_t,int> extraire() {
+        if (seaux[0].empty()) {
+            int i = 1;
+            while (seaux[i].empty()) i++;
+            // Nouvelle référence : la plus petite clé du premier seau non vide,
+            // dont les éléments se répartissent alors dans des seaux inférieurs
+            uint32_t mini = seaux[i][0].first;
+            for (auto& x : seaux[i]) mini = min(mini, x.first);
+            dernier = mini;
+            for (auto& x : seaux[i])
+                seaux[indice(x.first, dernier)].push_back(x);
+            seaux[i].clear();
+        }
+        pair<uint32_t,int> x = seaux[0].back();
+        seaux[0].pop_back();
+        taille--;
+        return x;
+    }
+};
+
+/* Dijkstra depuis source avec un tas fourni par l'appelant (réutilisé d'une
+ * source à l'autre par chaque thread). Les chemins de longueur >= INF ne sont
+ * pas explorés : la matrice de Floyd les sature à INF. */
+static void dijkstraTas(const GrapheCSR& g, int source, int* ligne, TasRadix& tas) {
+    fill(ligne, ligne + g.n, INF);
+    ligne[source] = 0;
+    tas.vider();
+    tas.inserer(0, source);
+    while (tas.taille > 0) {
+        pair<uint32_t,int> x = tas.extraire();
+        int u = x.second;
+        if ((int)x.first > ligne[u]) continue;   // entrée périmée
+        for (long a = g.debut[u]; a < g.debut[u+1]; a++) {
+            int v = g.voisins[a];
+            // Somme en long : un poids proche de INT_MAX ne déborde pas, et
+            // d < ligne[v] <= INF garantit que d tient dans un int
+            long d = (long)ligne[u] + g.poids[a];
+            if (d < ligne[v]) {
+                ligne[v] = (int)d;
+                tas.inserer((uint32_t)d, v);
+            }
+        }
+    }
+}
+
+void dijkstraSource(const GrapheCSR& g, int source, int* ligne) {
+    TasRadix tas;
+    dijkstraTas(g, source, ligne, tas);
+}
+
+int* apspCreuxLignes(const GrapheCSR& g, int premiere, int nb_lignes) {
+    int* lignes = new int[(long)nb_lignes * g.n];
+    #pragma omp parallel
+    {
+        TasRadix tas;
+        #pragma omp for schedule(dynamic, 4)
+        for (int s = 0; s < nb_lignes; s++)
+            dijkstraTas(g, premiere + s, lignes + (long)s * g.n, tas);
+    }
+    return lignes;
+}
+
+void trancheSources(int n, int pid, int nprocs, int* premiere, int* nb_lignes) {
+    *premiere = (int)((long)n * pid / nprocs);
+    *nb_lignes = (int)((long)n * (pid+1) / nprocs) - *premiere;
+}
+
+int* apspCreux(const GrapheCSR& g, int root, int num_threads, MPI_Comm comm) {
+    int pid, nprocs;
+    MPI_Comm_rank(comm, &pid);
+    MPI_Comm_size(comm, &nprocs);
+    if (num_threads > 0)
+        omp_set_num_threads(num_threads);
+
+    int premiere, nb_lignes;
+    trancheSources(g.n, pid, nprocs, &premiere, &nb_lignes);
+    int* lignes = apspCreuxLignes(g, premiere, nb_lignes);
+
+    // Rassemblement par lignes entières : les comptes restent petits même
+    // quand n² dépasse INT_MAX
+    MPI_Datatype type_ligne;
+    MPI_Type_contiguous(g.n, MPI_INT, &type_ligne);
+    MPI_Type_commit(&type_ligne);
+
+    vector<int> compte, depl;
+    int* D = nullptr;
+    if (pid == root) {
+        compte.resize(nprocs);
+        depl.resize(nprocs);
+        for (int p = 0; p < nprocs; p++)
+            trancheSources(g.n, p, nprocs, &depl[p], &compte[p]);
+        D = new int[(long)g.n * g.n];
+    }
+    MPI_Gatherv(lignes, nb_lignes, type_ligne, D, compte.data(), depl.data(),
+                type_ligne, root, comm);
+
+    MPI_Type_free(&type_ligne);
+    delete[] lignes;
+    return D;
+}
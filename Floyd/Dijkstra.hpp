@@ -0,0 +1,114 @@
+#ifndef DIJKSTRA_HPP
+#define DIJKSTRA_HPP
+
+#include <mpi.h>
+#include <vector>
+#include "ForGraph.hpp"
+#include "GrapheBinaire.hpp"
+
+using namespace std;
+
+/**
+ * @brief Densité (2m / n²) en dessous de laquelle le moteur creux (Dijkstra
+ *        multi-sources) est choisi automatiquement à la place de Floyd par blocs.
+ *        Modifiable à la compilation (-DFLOYD_DENSITE_CREUX=0.05).
+ *
+ * Dijkstra coûte O(n · m) et Floyd O(n³) : le rapport des deux ne dépend
+ * que de la densité. Avec les noyaux (min,+) vectorisés, les deux moteurs
+ * s'équilibrent vers une densité de 0.02 (mesuré pour n = 1000 à 3000).
+ */
+#ifndef FLOYD_DENSITE_CREUX
+#define FLOYD_DENSITE_CREUX 0.02
+#endif
+
+/**
+ * @brief Graphe non orienté au format CSR (Compressed Sparse Row) :
+ *        les voisins du sommet u sont voisins[debut[u] .. debut[u+1]-1],
+ *        avec les poids correspondants dans poids.
+ */
+struct GrapheCSR {
+    int n;                  /**< Nombre de sommets */
+    vector<long> debut;     /**< n+1 indices de début de liste */
+    vector<int> voisins;    /**< Sommets voisins */
+    vector<int> poids;      /**< Poids des arêtes */
+};
+
+/**
+ * @brief Construit le CSR à partir de triplets (u, v, poids) non orientés,
+ *        avec la même convention que lectureGraphe + InitDk : la dernière
+ *        occurrence d'une arête l'emporte, un poids nul signifie "pas d'arête",
+ *        les boucles sont ignorées.
+ *
+ * @param n Nombre de sommets
+ * @param aretes Triplets à la suite
+ * @param nb_aretes Nombre de triplets
+ */
+GrapheCSR csrDepuisAretes(int n, const int* aretes, long nb_aretes);
+
+/**
+ * @brief Construit le CSR à partir d'une matrice d'adjacence (0 = pas d'arête)
+ */
+GrapheCSR csrDepuisMatrice(int n, const int* mat_adjacence);
+
+/**
+ * @brief Construit le CSR à partir d'un fichier .gcsr projeté : copie directe
+ *        des tableaux pour un graphe non orienté (les poids nuls et les
+ *        boucles sont retirés), symétrisation par csrDepuisAretes sinon
+ */
+GrapheCSR csrDepuisVue(const VueCSR& vue);
+
+/**
+ * @brief Diffuse le CSR du processus root à tous les processus de comm
+ */
+void diffuserCSR(GrapheCSR& g, int root, MPI_Comm comm);
+
+/**
+ * @brief Vrai si au moins un arc a un poids négatif (Dijkstra exclu)
+ */
+bool poidsNegatifs(const GrapheCSR& g);
+
+/**
+ * @brief Choix automatique du moteur : vrai si la densité 2m / n² est
+ *        inférieure à FLOYD_DENSITE_CREUX et qu'aucun poids n'est négatif
+ *        (Dijkstra ne s'applique qu'aux poids positifs ou nuls)
+ */
+bool grapheCreux(const GrapheCSR& g);
+
+/**
+ * @brief Plus courts chemins depuis une source (Dijkstra avec tas radix,
+ *        poids entiers positifs). Les distances >= INF sont ramenées à INF,
+ *        comme dans la matrice de Floyd.
+ *
+ * @param g Graphe CSR
+ * @param source Sommet source
+ * @param ligne Sortie : n distances depuis la source
+ */
+void dijkstraSource(const GrapheCSR& g, int source, int* ligne);
+
+/**
+ * @brief Lignes [premiere, premiere + nb_lignes) de la matrice des distances,
+ *        une source par ligne, réparties entre les threads OpenMP.
+ *
+ * @return int* nb_lignes x n distances
+ */
+int* apspCreuxLignes(const GrapheCSR& g, int premiere, int nb_lignes);
+
+/**
+ * @brief Tranche de sources du processus pid parmi nprocs (blocs contigus)
+ */
+void trancheSources(int n, int pid, int nprocs, int* premiere, int* nb_lignes);
+
+/**
+ * @brief Matrice des distances complète par Dijkstra multi-sources
+ *        (VERSION HYBRIDE MPI+OpenMP) : les sources sont réparties par
+ *        tranches entre les processus, puis entre les threads.
+ *
+ * @param g Graphe CSR (identique sur tous les processus)
+ * @param root Processus racine
+ * @param num_threads Nombre de threads OpenMP (0 = automatique)
+ * @param comm Communicateur
+ * @return int* Matrice n x n (NULL si pid != root)
+ */
+int* apspCreux(const GrapheCSR& g, int root, int num_threads, MPI_Comm comm);
+
+#endif
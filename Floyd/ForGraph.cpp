@@ -1,13 +1,18 @@
 #include "ForGraph.hpp"
+#include "Lecture.hpp"
+#include <algorithm>
 
-int* lectureGraphe(char* f, int* nb_nodes, map<string, int>* my_nodes) {
+#ifdef WITH_GRAPHVIZ
+/* Lecture par libcgraph, pour les .dot que lectureRapide ne reconnaît pas
+ * (sous-graphes, ports, échappements...) */
+static int lectureCgraph(char* f, int* nb_nodes, map<string, int>* my_nodes, vector<int>* aretes) {
     FILE *fp = fopen(f, "r");
+    if (!fp) return -1;
     Agraph_t *g = agread(fp, NULL);
     fclose(fp);
+    if (!g) return -1;
 
-    int nn = agnnodes(g);
-
-    (*nb_nodes) = nn;
+    (*nb_nodes) = agnnodes(g);
 
     int t = 0;
     for (Agnode_t *n = agfstnode(g); n; n = agnxtnode(g, n)) {
@@ -15,6 +20,39 @@ int* lectureGraphe(char* f, int* nb_nodes, map<string, int>* my_nodes) {
         t++;
     }
 
+    aretes->reserve(3*agnedges(g));
+    for (Agnode_t *n = agfstnode(g); n; n = agnxtnode(g, n)) {
+        int i = (*my_nodes)[agnameof(n)];
+        for (Agedge_t *e = agfstout(g, n); e; e = agnxtout(g, e)) {
+            aretes->push_back(i);
+            aretes->push_back((*my_nodes)[agnameof(aghead(e))]);
+            aretes->push_back(std::stoi(agget(e, (char*)"weight")));
+        }
+    }
+    agclose(g);
+    return 0;
+}
+#endif
+
+vector<int> lectureAretes(char* f, int* nb_nodes, map<string, int>* my_nodes) {
+    vector<int> aretes;
+    (*nb_nodes) = -1;
+    if (lectureRapide(f, nb_nodes, my_nodes, &aretes) == 0)
+        return aretes;
+#ifdef WITH_GRAPHVIZ
+    aretes.clear();
+    my_nodes->clear();
+    if (lectureCgraph(f, nb_nodes, my_nodes, &aretes) == 0)
+        return aretes;
+#endif
+    (*nb_nodes) = -1;
+    return vector<int>();
+}
+
+int* lectureGraphe(char* f, int* nb_nodes, map<string, int>* my_nodes) {
+    vector<int> aretes = lectureAretes(f, nb_nodes, my_nodes);
+    if (*nb_nodes < 0) return nullptr;
+    long nn = *nb_nodes;
 
     /* La matrice d'adjacence est "normale" sans l'infini
      * C'est dans la construction de la matrice de distance initiale
@@ -22,86 +60,157 @@ int* lectureGraphe(char* f, int* nb_nodes, map<string, int>* my_nodes) {
      * correspond pas à une arête du graphe. 
      */
     int* mat_adjacence = new int[nn*nn]();
-    
-    int i, j;
-    int weight;
-    for (Agnode_t *n = agfstnode(g); n; n = agnxtnode(g, n)) {
-        i = (*my_nodes)[agnameof(n)];
-        for (Agedge_t *e = agfstout(g, n); e; e = agnxtout(g, e)) {
-            j = (*my_nodes)[agnameof(aghead(e))];
-            weight = std::stoi(agget(e, (char*)"weight"));
-            mat_adjacence[i*nn+j]=weight;
-            mat_adjacence[j*nn+i]=weight;
-     }
+    for (size_t a = 0; a < aretes.size(); a += 3) {
+        int i = aretes[a], j = aretes[a+1], weight = aretes[a+2];
+        mat_adjacence[i*nn+j]=weight;
+        mat_adjacence[j*nn+i]=weight;
     }
-    agclose(g);
     return mat_adjacence;
 }
 
-int* InitDk(int nb_nodes, int* mat_adjacence) {
-    int* Dk = new int[nb_nodes*nb_nodes];
+template<typename T>
+T* InitDk(int nb_nodes, int* mat_adjacence) {
+    long nn = nb_nodes;
+    T* Dk = new T[nn*nn];
+    // Un poids que T ne représente pas sous la sentinelle est saturé (au
+    // lieu d'être tronqué par la conversion) et signalé
+    const double borne = (double)Poids<T>::infini();
+    long satures = 0;
     for (int i=0; i<nb_nodes; i++)
-        for (int j=0; j<nb_nodes; j++)
+        for (int j=0; j<nb_nodes; j++) {
+            int w = mat_adjacence[i*nn+j];
             if (i==j)
-                Dk[i*nb_nodes+j] = 0;
-            else if (mat_adjacence[i*nb_nodes+j]==0)
-                Dk[i*nb_nodes+j] = INF;
-            else
-                Dk[i*nb_nodes+j] = mat_adjacence[i*nb_nodes+j];
+                Dk[i*nn+j] = 0;
+            else if (w==0)
+                Dk[i*nn+j] = Poids<T>::infini();
+            else if (w >= borne || -(double)w >= borne) {
+                Dk[i*nn+j] = w > 0 ? Poids<T>::infini() - 1 : -(Poids<T>::infini() - 1);
+                satures++;
+            } else
+                Dk[i*nn+j] = (T)w;
+        }
+    if (satures > 0)
+        cerr << "Attention : " << satures << " poids hors du type " << Poids<T>::nom()
+             << ", saturés" << endl;
     return Dk;
 }
 
-int* MatDistance(int nb_nodes, int* mat_adjacence) {
-    int* Dk = InitDk(nb_nodes, mat_adjacence);
-    int* Dk1 = new int[nb_nodes*nb_nodes]; 
-
-    for (int k=0; k<nb_nodes; k++) {
-        for (int i=0; i<nb_nodes; i++)
-            for (int j=0; j<nb_nodes; j++) {
-                if (Dk[i*nb_nodes+j] <= Dk[i*nb_nodes+k]+Dk[k*nb_nodes+j]) 
-                    Dk1[i*nb_nodes+j] = Dk[i*nb_nodes+j];
-                else 
-                    Dk1[i*nb_nodes+j] = Dk[i*nb_nodes+k]+Dk[k*nb_nodes+j];
-                
-            }
-        for (int i=0; i<nb_nodes*nb_nodes; i++)
-            Dk[i] = Dk1[i];
+/* Relaxation d'un segment de ligne : ci[j] = min(ci[j], a + bk[j]).
+ * ci et bk ne se recouvrent jamais (la ligne pivot est exclue par l'appelant),
+ * ce qui laisse le compilateur vectoriser la boucle.
+ */
+template<typename T>
+static void relaxerLigne(T* __restrict ci, T a, const T* __restrict bk, int len) {
+    for (int j=0; j<len; j++) {
+        T v = Poids<T>::plus(a, bk[j]);
+        ci[j] = (v < ci[j]) ? v : ci[j];
     }
-    delete[] Dk1;
-    return Dk;
 }
 
-int* MatDistance(int nb_nodes, int* mat_adjacence, int* next) {
-    int* Dk = InitDk(nb_nodes, mat_adjacence);
-    int* Dk1 = new int[nb_nodes*nb_nodes]; 
-
-    for (int k=0; k<nb_nodes; k++) {
-        for (int i=0; i<nb_nodes; i++)
-            for (int j=0; j<nb_nodes; j++) {
-                if (Dk[i*nb_nodes+j] <= Dk[i*nb_nodes+k]+Dk[k*nb_nodes+j]) 
-                    Dk1[i*nb_nodes+j] = Dk[i*nb_nodes+j];
-                else {
-                    Dk1[i*nb_nodes+j] = Dk[i*nb_nodes+k]+Dk[k*nb_nodes+j];
-                    next[i*nb_nodes+j] = next[i*nb_nodes+k];
+/* Relaxation de la tuile [i0,i1)x[j0,j1) par les pivots [k0,k1).
+ * La boucle k est la plus externe : c'est l'ordre de Floyd-Warshall,
+ * ce qui rend la mise à jour en place correcte même quand la tuile
+ * contient elle-même la ligne ou la colonne pivot.
+ */
+template<typename T>
+static void relaxerTuile(T* D, int* next, int n,
+                         int i0, int i1, int j0, int j1, int k0, int k1) {
+    for (int k=k0; k<k1; k++) {
+        const T* Dk = D + (long)k*n;
+        for (int i=i0; i<i1; i++) {
+            // D[k][k] = 0 : la ligne pivot est inchangée par son propre pivot
+            if (i == k) continue;
+            T* Di = D + (long)i*n;
+            T dik = Di[k];
+            if (next) {
+                for (int j=j0; j<j1; j++) {
+                    T v = Poids<T>::plus(dik, Dk[j]);
+                    if (v < Di[j]) {
+                        Di[j] = v;
+                        next[(long)i*n+j] = next[(long)i*n+k];
+                    }
                 }
+            } else {
+                relaxerLigne(Di+j0, dik, Dk+j0, j1-j0);
             }
-        for (int i=0; i<nb_nodes*nb_nodes; i++)
-            Dk[i] = Dk1[i];
+        }
     }
-    delete[] Dk1;
+}
+
+template<typename T>
+void floydTuiles(T* D, int nb_nodes, int* next, int tuile) {
+    int n = nb_nodes;
+    int t = (tuile > 0) ? tuile : n;
+    for (int kb=0; kb<n; kb+=t) {
+        int ke = min(kb+t, n);
+
+        // Tuile diagonale
+        relaxerTuile(D, next, n, kb, ke, kb, ke, kb, ke);
+
+        // Tuiles de la ligne et de la colonne pivot
+        for (int b=0; b<n; b+=t) {
+            if (b == kb) continue;
+            int be = min(b+t, n);
+            relaxerTuile(D, next, n, kb, ke, b, be, kb, ke);
+            relaxerTuile(D, next, n, b, be, kb, ke, kb, ke);
+        }
+
+        // Tuiles restantes
+        for (int ib=0; ib<n; ib+=t) {
+            if (ib == kb) continue;
+            int ie = min(ib+t, n);
+            for (int jb=0; jb<n; jb+=t) {
+                if (jb == kb) continue;
+                relaxerTuile(D, next, n, ib, ie, jb, min(jb+t, n), kb, ke);
+            }
+        }
+    }
+}
+
+template<typename T>
+T* MatDistance(int nb_nodes, int* mat_adjacence, int tuile) {
+    T* Dk = InitDk<T>(nb_nodes, mat_adjacence);
+    floydTuiles(Dk, nb_nodes, nullptr, tuile);
+    return Dk;
+}
+
+template<typename T>
+T* MatDistance(int nb_nodes, int* mat_adjacence, int* next, int tuile) {
+    T* Dk = InitDk<T>(nb_nodes, mat_adjacence);
+    floydTuiles(Dk, nb_nodes, next, tuile);
     return Dk;
 }
 
+/* Instanciations pour les types de poids de Poids.hpp */
+#define INSTANCIER_FLOYD(T) \
+    template T* InitDk<T>(int, int*); \
+    template void floydTuiles<T>(T*, int, int*, int); \
+    template T* MatDistance<T>(int, int*, int); \
+    template T* MatDistance<T>(int, int*, int*, int);
+INSTANCIER_FLOYD(int16_t)
+INSTANCIER_FLOYD(int32_t)
+INSTANCIER_FLOYD(int64_t)
+INSTANCIER_FLOYD(float)
+
 int* InitNext(int nb_nodes, int* mat_adjacence) {
-    int* next = new int[nb_nodes*nb_nodes];
+    long nn = nb_nodes;
+    int* next = new int[nn*nn];
     for (int i=0; i<nb_nodes; i++)
         for (int j=0; j<nb_nodes; j++)
-            if (mat_adjacence[i*nb_nodes+j]!=0)
-                next[i*nb_nodes+j]=j;
+            if (mat_adjacence[i*nn+j]!=0)
+                next[i*nn+j]=j;
             else
-                next[i*nb_nodes+j]=-1;
+                next[i*nn+j]=-1;
 
     return next;
 }
 
-
+vector<int> reconstruireChemin(const int* next, int nb_nodes, int i, int j) {
+    vector<int> chemin = {i};
+    while (i != j) {
+        i = next[(long)i*nb_nodes + j];
+        if (i < 0 || (int)chemin.size() > nb_nodes) return {};
+        chemin.push_back(i);
+    }
+    return chemin;
+}
@@ -2,46 +2,91 @@
 #define FORGRAPH_HPP
 
 #include <iostream>
+#ifdef WITH_GRAPHVIZ
 #include <graphviz/cgraph.h>
+#endif
 #include <map>
 #include <vector>
+#include "Poids.hpp"
 
 /**
- * @brief Pour représenter l'infini 
+ * @brief Pour représenter l'infini sur les poids int (sentinelle de
+ *        Poids<int>, voir Poids.hpp pour les autres types)
  * 
  */
-#define INF 1000
+#define INF (Poids<int>::infini())
+
+/**
+ * @brief Taille de tuile par défaut du Floyd-Warshall séquentiel par tuiles.
+ *        Modifiable à la compilation (-DFLOYD_TUILE=128) ou par l'argument
+ *        tuile de MatDistance.
+ */
+#ifndef FLOYD_TUILE
+#define FLOYD_TUILE 64
+#endif
 
 using namespace std;
 
 /**
  * @brief Lecture du graphe et génération de la matrice d'adjacence adaptée
- *        La librairie libcgraph.so de GraphViz est utilisée pour lire le graphe .dot
+ *        Le graphe (.dot ou liste d'arêtes) est lu par le lecteur natif
+ *        lectureRapide (Lecture.hpp) ; compilé avec -DWITH_GRAPHVIZ, les .dot
+ *        hors de son format sont relus avec libcgraph de GraphViz
  * @param f le fichier .dot contenant le graphe
  * @param nb_nodes le nombre de sommets du graphe (sortie)
- * @param my_nodes ll
- * @return int* en retour la matrice d'adjacence non adaptée
+ * @param my_nodes correspondance nom -> numéro des sommets (sortie)
+ * @return int* en retour la matrice d'adjacence non adaptée (nullptr si
+ *         le fichier n'a pas pu être lu)
  */
 int* lectureGraphe(char* f, int* nb_nodes, map<string, int>* my_nodes);
 
+/**
+ * @brief Lecture du graphe sous forme de liste d'arêtes, sans matrice n x n.
+ *        Même lecteur et même numérotation des sommets que lectureGraphe.
+ * @param f le fichier .dot contenant le graphe
+ * @param nb_nodes le nombre de sommets du graphe (sortie, -1 si le fichier
+ *        n'a pas pu être lu)
+ * @param my_nodes correspondance nom -> numéro des sommets (sortie)
+ * @return vector<int> les triplets (u, v, poids) à la suite
+ */
+vector<int> lectureAretes(char* f, int* nb_nodes, map<string, int>* my_nodes);
+
 /**
  * @brief Pour initialiser D^(-1) avant les nb_nodes itérations du calcul
  *        de la matrice de distance
  * 
+ * @tparam T type des poids (int16_t, int32_t, int64_t ou float)
  * @param nb_nodes le nombre de noeuds
  * @param mat_adjacence la matrice d'adjacence normale
- * @return int* la matrice D^(-1) 
+ * @return T* la matrice D^(-1), Poids<T>::infini() hors arêtes
  */
-int* InitDk(int nb_nodes, int* mat_adjacence);
+template<typename T = int>
+T* InitDk(int nb_nodes, int* mat_adjacence);
+
+/**
+ * @brief Floyd-Warshall séquentiel par tuiles, en place dans D.
+ *        Pour chaque bande pivot k : tuile diagonale, puis tuiles de la
+ *        ligne et de la colonne k, puis les tuiles restantes. Les tuiles
+ *        de bord (nb_nodes non multiple de tuile) sont simplement plus petites.
+ * 
+ * @param D la matrice D^(-1) (modifiée en place, devient D^(nb_nodes))
+ * @param nb_nodes le nombre de noeuds
+ * @param next la matrice next à mettre à jour (nullptr si inutile)
+ * @param tuile la taille des tuiles
+ */
+template<typename T>
+void floydTuiles(T* D, int nb_nodes, int* next, int tuile);
 
 /**
  * @brief Calcul de la matrice de distance seule
  * 
  * @param nb_nodes le nombre de noeuds
  * @param mat_adjacence la matrice d'adjacence normale
- * @return int* la matrice des distances autrement dit D à l'itération nb_nodes.
+ * @param tuile la taille des tuiles du calcul en place
+ * @return T* la matrice des distances autrement dit D à l'itération nb_nodes.
  */
-int* MatDistance(int nb_nodes, int* mat_adjacence);
+template<typename T = int>
+T* MatDistance(int nb_nodes, int* mat_adjacence, int tuile = FLOYD_TUILE);
 
 /**
  * @brief 
@@ -72,9 +117,23 @@ int* InitNext(int nb_nodes, int* mat_adjacence);
  * @param nb_nodes le nombre de noeuds
  * @param mat_adjacence la matrice d'adjacence
  * @param next la matrice next initialisée par la fonction précédente
- * @return int* la matrice des distances autrement dit D à l'itération nb_nodes.
+ * @param tuile la taille des tuiles du calcul en place
+ * @return T* la matrice des distances autrement dit D à l'itération nb_nodes.
+ */
+template<typename T = int>
+T* MatDistance(int nb_nodes, int* mat_adjacence, int* next, int tuile = FLOYD_TUILE);
+
+/**
+ * @brief Reconstruit le plus court chemin de i à j à partir d'une matrice next
+ *        (séquentielle ou rassemblée depuis les successeurs distribués)
+ * 
+ * @param next la matrice des successeurs
+ * @param nb_nodes le nombre de noeuds
+ * @param i sommet de départ
+ * @param j sommet d'arrivée
+ * @return vector<int> les sommets du chemin, i et j compris (vide si aucun chemin)
  */
-int* MatDistance(int nb_nodes, int* mat_adjacence, int* next);
+vector<int> reconstruireChemin(const int* next, int nb_nodes, int i, int j);
 
 
 
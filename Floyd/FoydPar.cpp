@@ -5,62 +5,267 @@
 #include <cmath>
 #include <algorithm>
 #include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <fcntl.h>
+#include <unistd.h>
 #include "ForGraph.hpp"
 #include "FoydPar.hpp"
 #include "Utils.hpp"
+#include "MinPlus.hpp"
+#include "SemiAnneau.hpp"
 using namespace std;
 
-inline int& A(int* B, int b, int i, int j) { return B[i*b + j]; }
-
-void decouperMatrice(int* D, int* D_local, int n, int block_size, int p_sqrt, int root, int pid) {
-    if(pid==root){
-        int* temp = new int[block_size*block_size];
-        for(int bi=0; bi<p_sqrt; bi++)
-            for(int bj=0; bj<p_sqrt; bj++){
-                int dest = bi*p_sqrt + bj;
-                for(int i=0;i<block_size;i++)
-                    for(int j=0;j<block_size;j++)
-                        temp[i*block_size+j] = D[(bi*block_size+i)*n + (bj*block_size+j)];
-                if(dest==root)
-                    copy(temp,temp+block_size*block_size,D_local);
-                else
-                    MPI_Send(temp, block_size*block_size, MPI_INT, dest, 0, MPI_COMM_WORLD);
-            }
-        delete[] temp;
-    } else {
-        MPI_Recv(D_local, block_size*block_size, MPI_INT, root, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+/* Nombre d'indices de blocs I < nblocs tels que I % p == coord */
+static int nbBlocsLocaux(int nblocs, int coord, int p) {
+    return (nblocs - coord + p - 1) / p;
+}
+
+/* Bloc local (li, lj) de D_local, ou du tableau symétrique si tri est non
+ * nul (nullptr sous la diagonale) */
+template<typename T>
+static T* blocStocke(T* D_local, const Distribution& d, const Triangle* tri, int li, int lj) {
+    return tri ? blocTriangle(D_local, d, *tri, li, lj) : blocLocal(D_local, d, li, lj);
+}
+
+Triangle creerTriangle(const Distribution& d) {
+    Triangle t;
+    t.premiere.resize(d.lignes);
+    t.debut.assign(d.lignes + 1, 0);
+    for (int li = 0; li < d.lignes; li++) {
+        // Première colonne locale lj telle que lj*pc + py >= I
+        int I = blocGlobalLigne(d, li);
+        t.premiere[li] = min(d.colonnes, max(0, (I - d.g.py + d.g.pc - 1) / d.g.pc));
+        t.debut[li+1] = t.debut[li] + d.colonnes - t.premiere[li];
     }
+    return t;
+}
+
+/* Remplit les entrées de complétion (au-delà de n) des blocs locaux du
+ * dernier bloc-ligne ou bloc-colonne : infini, 0 sur la diagonale */
+template<typename T>
+static void remplirComplement(T* D_local, const Distribution& d, const Triangle* tri) {
+    int n = d.n, nb = d.nb;
+    for (int li = 0; li < d.lignes; li++)
+        for (int lj = 0; lj < d.colonnes; lj++) {
+            int i0 = blocGlobalLigne(d, li)*nb, j0 = blocGlobalColonne(d, lj)*nb;
+            T* B = blocStocke(D_local, d, tri, li, lj);
+            if ((i0 + nb <= n && j0 + nb <= n) || !B) continue;
+            for (int i = 0; i < nb; i++)
+                for (int j = 0; j < nb; j++)
+                    if (i0+i >= n || j0+j >= n)
+                        B[i*nb + j] = (i0+i == j0+j) ? 0 : Poids<T>::infini();
+        }
 }
 
-int* rassemblerMatrice(int* D_local, int n, int block_size, int p_sqrt, int root, int pid)
+/* Type dérivé décrivant, dans une matrice globale n x n, les blocs locaux du
+ * processus (px, py) dans l'ordre de son D_local (entrées de complétion exclues).
+ * Chaque bloc est un MPI_Type_create_subarray de la matrice entière ; les
+ * sous-tableaux sont assemblés par MPI_Type_create_struct (déplacements nuls).
+ * elem est le type MPI d'un poids. En mode symétrique, seuls les blocs (I, J)
+ * avec I <= J sont décrits.
+ */
+static MPI_Datatype typeBlocsGlobaux(const Distribution& d, int px, int py, MPI_Datatype elem,
+                                     bool symetrique) {
+    int n = d.n, nb = d.nb;
+    int lignes = nbBlocsLocaux(d.nblocs, px, d.g.pr);
+    int colonnes = nbBlocsLocaux(d.nblocs, py, d.g.pc);
+    vector<MPI_Datatype> types;
+    int tailles[2] = {n, n};
+    for (int li = 0; li < lignes; li++)
+        for (int lj = 0; lj < colonnes; lj++) {
+            int I = li*d.g.pr + px, J = lj*d.g.pc + py;
+            if (symetrique && I > J) continue;
+            int sous[2] = {min(nb, n-I*nb), min(nb, n-J*nb)};
+            int debut[2] = {I*nb, J*nb};
+            types.push_back(MPI_DATATYPE_NULL);
+            MPI_Type_create_subarray(2, tailles, sous, debut, MPI_ORDER_C, elem, &types.back());
+        }
+    int nbl = (int)types.size();
+    vector<int> longueurs(nbl, 1);
+    vector<MPI_Aint> depl(nbl, 0);
+    MPI_Datatype t;
+    MPI_Type_create_struct(nbl, longueurs.data(), depl.data(), types.data(), &t);
+    MPI_Type_commit(&t);
+    for (MPI_Datatype& x : types) MPI_Type_free(&x);
+    return t;
+}
+
+/* Type dérivé des mêmes entrées, vues depuis le D_local du processus courant
+ * (ou son tableau symétrique, les blocs stockés y étant à la suite) */
+static MPI_Datatype typeBlocsLocaux(const Distribution& d, MPI_Datatype elem, bool symetrique) {
+    int n = d.n, nb = d.nb;
+    vector<MPI_Datatype> types;
+    vector<MPI_Aint> depl;
+    int tailles[2] = {nb, nb};
+    int debut[2] = {0, 0};
+    MPI_Aint borne, etendue;
+    MPI_Type_get_extent(elem, &borne, &etendue);
+    for (int li = 0; li < d.lignes; li++)
+        for (int lj = 0; lj < d.colonnes; lj++) {
+            int i0 = blocGlobalLigne(d, li)*nb, j0 = blocGlobalColonne(d, lj)*nb;
+            if (symetrique && i0 > j0) continue;
+            int sous[2] = {min(nb, n-i0), min(nb, n-j0)};
+            depl.push_back((MPI_Aint)types.size()*nb*nb*etendue);
+            types.push_back(MPI_DATATYPE_NULL);
+            MPI_Type_create_subarray(2, tailles, sous, debut, MPI_ORDER_C, elem, &types.back());
+        }
+    int nbl = (int)types.size();
+    vector<int> longueurs(nbl, 1);
+    MPI_Datatype t;
+    MPI_Type_create_struct(nbl, longueurs.data(), depl.data(), types.data(), &t);
+    MPI_Type_commit(&t);
+    for (MPI_Datatype& x : types) MPI_Type_free(&x);
+    return t;
+}
+
+/* Transfert entre la matrice globale D (sur root) et les D_local, dans le
+ * sens de la découpe (vers_local) ou du rassemblement. Aucun tampon
+ * intermédiaire : les types dérivés lisent et écrivent en place des deux côtés.
+ */
+template<typename T>
+static void transfererBlocs(T* D, T* D_local, const Distribution& dist, int root,
+                            bool vers_local, bool symetrique) {
+    int pid, nprocs;
+    MPI_Comm_rank(dist.g.grille, &pid);
+    MPI_Comm_size(dist.g.grille, &nprocs);
+
+    vector<MPI_Request> req;
+    vector<MPI_Datatype> types;
+    MPI_Datatype type_local = typeBlocsLocaux(dist, typeMPI<T>(), symetrique);
+    req.push_back(MPI_REQUEST_NULL);
+    if (vers_local)
+        MPI_Irecv(D_local, 1, type_local, root, 0, dist.g.grille, &req.back());
+    else
+        MPI_Isend(D_local, 1, type_local, root, 0, dist.g.grille, &req.back());
+
+    if (pid == root) {
+        for (int p = 0; p < nprocs; p++) {
+            int coords[2];
+            MPI_Cart_coords(dist.g.grille, p, 2, coords);
+            types.push_back(typeBlocsGlobaux(dist, coords[0], coords[1], typeMPI<T>(), symetrique));
+            req.push_back(MPI_REQUEST_NULL);
+            if (vers_local)
+                MPI_Isend(D, 1, types.back(), p, 0, dist.g.grille, &req.back());
+            else
+                MPI_Irecv(D, 1, types.back(), p, 0, dist.g.grille, &req.back());
+        }
+    }
+
+    MPI_Waitall((int)req.size(), req.data(), MPI_STATUSES_IGNORE);
+    MPI_Type_free(&type_local);
+    for (MPI_Datatype& t : types) MPI_Type_free(&t);
+}
+
+template<typename T>
+void decouperMatrice(T* D, T* D_local, const Distribution& dist, int root, const Triangle* tri) {
+    remplirComplement(D_local, dist, tri);
+    transfererBlocs(D, D_local, dist, root, true, tri != nullptr);
+}
+
+template<typename T>
+T* rassemblerMatrice(T* D_local, const Distribution& dist, int root, const Triangle* tri)
 {
-    int bloc_elem = block_size * block_size;
-    int nb_procs = p_sqrt * p_sqrt;
+    int pid;
+    MPI_Comm_rank(dist.g.grille, &pid);
+    long n = dist.n;
+    T* D = (pid == root) ? new T[n * n] : nullptr;
+    transfererBlocs(D, D_local, dist, root, false, tri != nullptr);
+    if (D && tri) {
+        // Blocs sous la diagonale : transposées de leurs symétriques
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (long i = 0; i < n; i++)
+            for (long j = 0; j < i / dist.nb * dist.nb; j++)
+                D[i*n + j] = D[j*n + i];
+    }
+    return D;
+}
+
+/* Propriétaire de l'entrée (i, j) dans la grille */
+static int proprietaire(const Distribution& d, int i, int j) {
+    int coords[2] = {(i / d.nb) % d.g.pr, (j / d.nb) % d.g.pc};
+    int rang;
+    MPI_Cart_rank(d.g.grille, coords, &rang);
+    return rang;
+}
 
-    int* gathered = nullptr;
-    if (pid == root)
-        gathered = new int[bloc_elem * nb_procs];
+template<typename T>
+void construireLocale(T* D_local, const Distribution& dist,
+                      const int* aretes, long nb_aretes, const Triangle* tri) {
+    int nb = dist.nb;
+    const T inf = Poids<T>::infini();
+    for (int li = 0; li < dist.lignes; li++)
+        for (int lj = 0; lj < dist.colonnes; lj++) {
+            int i0 = blocGlobalLigne(dist, li)*nb, j0 = blocGlobalColonne(dist, lj)*nb;
+            T* B = blocStocke(D_local, dist, tri, li, lj);
+            if (!B) continue;
+            for (int i = 0; i < nb; i++)
+                for (int j = 0; j < nb; j++)
+                    B[i*nb + j] = (i0+i == j0+j) ? 0 : inf;
+        }
 
-    MPI_Gather(D_local, bloc_elem, MPI_INT,
-               gathered, bloc_elem, MPI_INT,
-               root, MPI_COMM_WORLD);
+    // Même convention que lectureGraphe + InitDk : arête non orientée, la
+    // dernière occurrence l'emporte, un poids nul signifie "pas d'arête"
+    for (long e = 0; e < nb_aretes; e++) {
+        int u = aretes[3*e], v = aretes[3*e+1], w = aretes[3*e+2];
+        if (u == v) continue;
+        T val = (w == 0) ? inf : (T)w;
+        for (int sens = 0; sens < 2; sens++) {
+            int i = sens ? v : u, j = sens ? u : v;
+            int I = i / nb, J = j / nb;
+            if (I % dist.g.pr != dist.g.px || J % dist.g.pc != dist.g.py || (tri && I > J)) continue;
+            blocStocke(D_local, dist, tri, I / dist.g.pr, J / dist.g.pc)[(i % nb)*nb + j % nb] = val;
+        }
+    }
+}
 
+/* Arêtes dont ce processus possède l'entrée (u,v) ou (v,u), réparties par
+ * le root (MPI_Scatterv) */
+static vector<int> aretesLocales(const int* aretes, long nb_aretes,
+                                 const Distribution& dist, int root) {
+    int pid, nprocs;
+    MPI_Comm_rank(dist.g.grille, &pid);
+    MPI_Comm_size(dist.g.grille, &nprocs);
+
+    // Le root range chaque arête chez le(s) propriétaire(s) de (u,v) et (v,u),
+    // en conservant l'ordre du fichier
+    vector<int> compte(nprocs, 0), depl(nprocs, 0), envoi;
     if (pid == root) {
-        int* D = new int[n * n];
-        for (int p = 0; p < nb_procs; p++) {
-            int bi = p / p_sqrt;
-            int bj = p % p_sqrt;
-            int* src = gathered + p * bloc_elem;
-            for (int i = 0; i < block_size; i++)
-                for (int j = 0; j < block_size; j++)
-                    D[(bi * block_size + i) * n + (bj * block_size + j)] =
-                        src[i * block_size + j];
+        vector<int> dest(2*nb_aretes);
+        for (long e = 0; e < nb_aretes; e++) {
+            int u = aretes[3*e], v = aretes[3*e+1];
+            dest[2*e] = proprietaire(dist, u, v);
+            dest[2*e+1] = proprietaire(dist, v, u);
+            compte[dest[2*e]] += 3;
+            if (dest[2*e+1] != dest[2*e]) compte[dest[2*e+1]] += 3;
         }
-        delete[] gathered;
-        return D;
+        for (int p = 1; p < nprocs; p++) depl[p] = depl[p-1] + compte[p-1];
+        envoi.resize(depl[nprocs-1] + compte[nprocs-1]);
+        vector<int> pos(depl);
+        for (long e = 0; e < nb_aretes; e++)
+            for (int s = 0; s < 2; s++) {
+                if (s == 1 && dest[2*e+1] == dest[2*e]) break;
+                int p = dest[2*e+s];
+                copy(aretes + 3*e, aretes + 3*e + 3, envoi.begin() + pos[p]);
+                pos[p] += 3;
+            }
     }
 
-    return nullptr;
+    int nb_recus;
+    MPI_Scatter(compte.data(), 1, MPI_INT, &nb_recus, 1, MPI_INT, root, dist.g.grille);
+    vector<int> recus(nb_recus);
+    MPI_Scatterv(envoi.data(), compte.data(), depl.data(), MPI_INT,
+                 recus.data(), nb_recus, MPI_INT, root, dist.g.grille);
+
+    return recus;
+}
+
+template<typename T>
+void distribuerAretes(const int* aretes, long nb_aretes, T* D_local,
+                      const Distribution& dist, int root, const Triangle* tri) {
+    vector<int> recus = aretesLocales(aretes, nb_aretes, dist, root);
+    construireLocale(D_local, dist, recus.data(), (long)recus.size() / 3, tri);
 }
 
 void afficherBloc(int* D_local, int block_size, int pid, int nprocs, const string &titre){
@@ -79,156 +284,2272 @@ void afficherBloc(int* D_local, int block_size, int pid, int nprocs, const strin
     }
 }
 
+/* Fermeture (Floyd-Warshall) du bloc diagonal, découpé en sous-tuiles.
+ * Chaque mise à jour de sous-tuile est une tâche OpenMP ; les clauses depend
+ * sur le premier élément de chaque sous-tuile reproduisent l'ordre
+ * diagonale -> ligne/colonne -> reste de chaque étape kt, ce qui laisse
+ * les tâches d'étapes différentes se chevaucher sans course sur kk.
+ * Si N est non nul, les successeurs sont mis à jour avec D (minPlusSuivant).
+ */
+template<typename T>
+static void fermetureBlocTaches(T* D, int* N, int b) {
+    const int t = FLOYD_SOUS_TUILE;
+    #pragma omp parallel
+    #pragma omp single
+    for (int k0=0; k0<b; k0+=t) {
+        int kc = min(t, b-k0);
+        T* Dkk = D + k0*b + k0;
+
+        #pragma omp task depend(inout: Dkk[0])
+        if (N) minPlusSuivant(kc, kc, kc, Dkk, N + k0*b + k0, b, Dkk, b, Dkk, N + k0*b + k0, b);
+        else   minPlusEnPlace(kc, kc, kc, Dkk, b, Dkk, b, Dkk, b);
+
+        for (int j0=0; j0<b; j0+=t) {
+            if (j0 == k0) continue;
+            int w = min(t, b-j0);
+            T* Dkj = D + k0*b + j0;
+            T* Djk = D + j0*b + k0;
+            #pragma omp task depend(in: Dkk[0]) depend(inout: Dkj[0])
+            if (N) minPlusSuivant(kc, w, kc, Dkk, N + k0*b + k0, b, Dkj, b, Dkj, N + k0*b + j0, b);
+            else   minPlusEnPlace(kc, w, kc, Dkk, b, Dkj, b, Dkj, b);
+            #pragma omp task depend(in: Dkk[0]) depend(inout: Djk[0])
+            if (N) minPlusSuivant(w, kc, kc, Djk, N + j0*b + k0, b, Dkk, b, Djk, N + j0*b + k0, b);
+            else   minPlusEnPlace(w, kc, kc, Djk, b, Dkk, b, Djk, b);
+        }
+
+        for (int i0=0; i0<b; i0+=t) {
+            if (i0 == k0) continue;
+            int h = min(t, b-i0);
+            T* Dik = D + i0*b + k0;
+            for (int j0=0; j0<b; j0+=t) {
+                if (j0 == k0) continue;
+                int w = min(t, b-j0);
+                T* Dkj = D + k0*b + j0;
+                T* Dij = D + i0*b + j0;
+                #pragma omp task depend(in: Dik[0], Dkj[0]) depend(inout: Dij[0])
+                if (N) minPlusSuivant(h, w, kc, Dik, N + i0*b + k0, b, Dkj, b, Dij, N + i0*b + j0, b);
+                else   minPlusProduit(h, w, kc, Dik, b, Dkj, b, Dij, b);
+            }
+        }
+    }
+}
+
+/* Bloc de la ligne pivot : C = min(C, P ⊗ C) avec P = bloc pivot déjà fermé.
+ * P étant fermé (diagonale nulle), le résultat ne dépend que des colonnes
+ * d'origine de C : les bandes de colonnes sont indépendantes. Avec les
+ * successeurs (NC non nul), chaque bande est traitée en place dans l'ordre
+ * de Floyd-Warshall, le successeur venant de NP.
+ */
+template<typename T>
+static void majBlocLignePivot(T* C, int* NC, const T* P, const int* NP, int b) {
+    const int t = FLOYD_SOUS_TUILE;
+    #pragma omp parallel
+    {
+        vector<T> bande;
+        #pragma omp for schedule(dynamic)
+        for (int j0=0; j0<b; j0+=t) {
+            int w = min(t, b-j0);
+            if (NC) {
+                minPlusSuivant(b, w, b, P, NP, b, C + j0, b, C + j0, NC + j0, b);
+                continue;
+            }
+            bande.resize(b*w);
+            for (int i=0; i<b; i++)
+                copy(C + i*b + j0, C + i*b + j0 + w, bande.data() + i*w);
+            minPlusProduit(b, w, b, P, b, bande.data(), w, C + j0, b);
+        }
+    }
+}
+
+/* Bloc de la colonne pivot : C = min(C, C ⊗ P), bandes de lignes indépendantes.
+ * Le successeur vient de la ligne de C elle-même (NC). */
+template<typename T>
+static void majBlocColonnePivot(T* C, int* NC, const T* P, int b) {
+    const int t = FLOYD_SOUS_TUILE;
+    #pragma omp parallel
+    {
+        vector<T> bande;
+        #pragma omp for schedule(dynamic)
+        for (int i0=0; i0<b; i0+=t) {
+            int h = min(t, b-i0);
+            if (NC) {
+                minPlusSuivant(h, b, b, C + i0*b, NC + i0*b, b, P, b, C + i0*b, NC + i0*b, b);
+                continue;
+            }
+            bande.assign(C + i0*b, C + (i0+h)*b);
+            minPlusProduit(h, b, b, bande.data(), b, P, b, C + i0*b, b);
+        }
+    }
+}
+
+/* ============ Opérations sur les blocs propres à chaque semi-anneau ============
+ * fermerBloc : fermeture du bloc pivot ; majLignePivot : C = P ⊗ C ;
+ * majColonnePivot : C = C ⊗ P ; majBande : h lignes de C ⊕= A ⊗ B (phase 5,
+ * C, A avancés à la première ligne). Les successeurs (N) n'existent qu'en (min,+).
+ */
+template<typename P>
+static void fermerBloc(MinPlus<P>, P* D, int* N, int b) {
+    fermetureBlocTaches(D, N, b);
+}
+
+template<typename P>
+static void majLignePivot(MinPlus<P>, P* C, int* NC, const P* Pv, const int* NP, int b) {
+    majBlocLignePivot(C, NC, Pv, NP, b);
+}
+
+template<typename P>
+static void majColonnePivot(MinPlus<P>, P* C, int* NC, const P* Pv, int b) {
+    majBlocColonnePivot(C, NC, Pv, b);
+}
+
+template<typename P>
+static void majBande(MinPlus<P>, P* C, int* NC, const P* A, const int* NA, const P* B, int h, int nb) {
+    if (NC) minPlusSuivant(h, nb, nb, A, NA, nb, B, nb, C, NC, nb);
+    else    minPlusProduit(h, nb, nb, A, nb, B, nb, C, nb);
+}
+
+/* (max,min) : mêmes indépendances qu'en (min,+), bandes de colonnes pour la
+ * ligne pivot et bandes de lignes pour la colonne pivot */
+template<typename P>
+static void fermerBloc(MaxMin<P>, P* D, int*, int b) {
+    maxMinEnPlace(b, b, b, D, b, D, b, D, b);
+}
+
+template<typename P>
+static void majLignePivot(MaxMin<P>, P* C, int*, const P* Pv, const int*, int b) {
+    #pragma omp parallel for schedule(dynamic)
+    for (int j0=0; j0<b; j0+=FLOYD_SOUS_TUILE)
+        maxMinEnPlace(b, min(FLOYD_SOUS_TUILE, b-j0), b, Pv, b, C + j0, b, C + j0, b);
+}
+
+template<typename P>
+static void majColonnePivot(MaxMin<P>, P* C, int*, const P* Pv, int b) {
+    #pragma omp parallel for schedule(dynamic)
+    for (int i0=0; i0<b; i0+=FLOYD_SOUS_TUILE)
+        maxMinEnPlace(min(FLOYD_SOUS_TUILE, b-i0), b, b, C + i0*b, b, Pv, b, C + i0*b, b);
+}
+
+template<typename P>
+static void majBande(MaxMin<P>, P* C, int*, const P* A, const int*, const P* B, int h, int nb) {
+    maxMinProduit(h, nb, nb, A, nb, B, nb, C, nb);
+}
+
+/* Accessibilité : blocs de nb lignes de w mots ; les panneaux pivots coûtent
+ * nb² w opérations, négligeables devant la phase 5 */
+static void fermerBloc(Accessibilite, uint64_t* D, int*, int b) {
+    int w = Accessibilite::mots(b);
+    boolEnPlace(b, b, w, D, D, D);
+}
+
+static void majLignePivot(Accessibilite, uint64_t* C, int*, const uint64_t* Pv, const int*, int b) {
+    int w = Accessibilite::mots(b);
+    boolEnPlace(b, b, w, Pv, C, C);
+}
+
+static void majColonnePivot(Accessibilite, uint64_t* C, int*, const uint64_t* Pv, int b) {
+    int w = Accessibilite::mots(b);
+    boolEnPlace(b, b, w, C, Pv, C);
+}
+
+static void majBande(Accessibilite, uint64_t* C, int*, const uint64_t* A, const int*,
+                     const uint64_t* B, int h, int nb) {
+    boolProduit(h, nb, Accessibilite::mots(nb), A, B, C);
+}
+
+GrilleProcessus creerGrille(int pr, int pc, MPI_Comm comm) {
+    GrilleProcessus g;
+    int dims[2] = {pr, pc};
+    int periods[2] = {0, 0};
+    int coords[2];
+    // Pas de renumérotation : le rang dans la grille reste celui de comm
+    MPI_Cart_create(comm, 2, dims, periods, 0, &g.grille);
+    int rang;
+    MPI_Comm_rank(g.grille, &rang);
+    MPI_Cart_coords(g.grille, rang, 2, coords);
+    g.pr = pr;
+    g.pc = pc;
+    g.px = coords[0];
+    g.py = coords[1];
+
+    int garder_ligne[2] = {0, 1};
+    int garder_colonne[2] = {1, 0};
+    MPI_Cart_sub(g.grille, garder_ligne, &g.ligne);
+    MPI_Cart_sub(g.grille, garder_colonne, &g.colonne);
+    return g;
+}
+
+void libererGrille(GrilleProcessus& g) {
+    MPI_Comm_free(&g.ligne);
+    MPI_Comm_free(&g.colonne);
+    MPI_Comm_free(&g.grille);
+}
+
+Distribution creerDistribution(int n, int nb, int pr, int pc, MPI_Comm comm) {
+    int nprocs;
+    MPI_Comm_size(comm, &nprocs);
+    if (pr <= 0 || pc <= 0 || pr*pc != nprocs) {
+        int dims[2] = {0, 0};
+        MPI_Dims_create(nprocs, 2, dims);
+        pr = dims[0];
+        pc = dims[1];
+    }
+    if (nb <= 0)
+        nb = max(1, min(256, (n + max(pr, pc) - 1) / max(pr, pc)));
+
+    Distribution d;
+    d.g = creerGrille(pr, pc, comm);
+    d.n = n;
+    d.nb = nb;
+    d.nblocs = (n + nb - 1) / nb;
+    d.lignes = nbBlocsLocaux(d.nblocs, d.g.px, pr);
+    d.colonnes = nbBlocsLocaux(d.nblocs, d.g.py, pc);
+    return d;
+}
+
+void libererDistribution(Distribution& d) {
+    libererGrille(d.g);
+}
+
+/* État d'une exécution de la fermeture par blocs sur un processus, pour le
+ * semi-anneau S (éléments de type T, w éléments par ligne de bloc) */
+template<typename S>
+struct Moteur {
+    typedef typename S::T T;
+    const Distribution* d;
+    T* D_local;
+    int* N_local;               // successeurs (nullptr si non demandés)
+    int w;                      // éléments par ligne de bloc
+    int bb;                     // nb*w, taille d'un bloc
+    int bbN;                    // nb*nb, taille d'un bloc de successeurs
+    T* pivot;                   // bloc pivot reçu
+    int* pivotN;                // successeurs du pivot reçus
+    T* ligne_k[2];              // ligne de blocs K reçue (colonnes blocs)
+    T* colonne_k[2];            // colonne de blocs K reçue (lignes blocs)
+    int* colonneN_k[2];         // successeurs de la colonne de blocs K
+    MPI_Datatype type_bloc;     // un bloc nb x nb contigu
+    MPI_Datatype type_colonne;  // bloc suivant de la colonne locale (pas colonnes*nb*nb)
+    MPI_Datatype type_blocN;    // mêmes types pour les successeurs (int)
+    MPI_Datatype type_colonneN;
+    TempsPhases* temps;         // temps des phases (nullptr si non mesurés)
+    bool saut;                  // résumés tenus à jour (FLOYD_SAUT_TUILES)
+    int bandes;                 // bandes de FLOYD_SOUS_TUILE lignes par bloc
+    vector<Resume<T> > resume;  // résumé de chaque bande des blocs locaux
+    vector<Resume<T> > resume_ligne[2];   // résumés de la ligne de blocs K reçue
+    vector<Resume<T> > resume_colonne[2]; // résumés de la colonne de blocs K reçue
+    uint64_t empreinte;         // empreinte des blocs initiaux (points de reprise)
+
+    /* Ajoute le temps écoulé depuis t0 à une phase de l'étape K */
+    void compter(PhaseFloyd phase, int K, double t0) const {
+        static double TempsPhases::* const champs[NB_PHASES] = {
+            &TempsPhases::panneaux, &TempsPhases::diffusion, &TempsPhases::reste, &TempsPhases::attente};
+        double dt = MPI_Wtime() - t0;
+        temps->*champs[phase] += dt;
+        if(temps->par_etape)
+            temps->etapes[(long)K*NB_PHASES + phase] += dt;
+    }
+
+    /* Bloc local (li, lj) d'un tableau de blocs de taille t */
+    template<typename U>
+    U* bloc(U* X, int t, int li, int lj) const {
+        return X + ((long)li * d->colonnes + lj) * t;
+    }
+
+    /* Recalcule le résumé de la bande b du bloc local (li, lj) */
+    void resumerBande(int li, int lj, int b) {
+        int i0 = b*FLOYD_SOUS_TUILE, h = min(FLOYD_SOUS_TUILE, d->nb - i0);
+        resume[((long)li * d->colonnes + lj) * bandes + b] =
+            resumer(bloc(D_local, bb, li, lj) + (long)i0*w, (long)h*w);
+    }
+
+    void resumerBloc(int li, int lj) {
+        for(int b=0; b<bandes; b++) resumerBande(li, lj, b);
+    }
+
+    /* Résumé d'un bloc entier à partir de ses bandes */
+    Resume<T> joindreBandes(const Resume<T>* r) const {
+        Resume<T> x = r[0];
+        for(int b=1; b<bandes; b++) joindre(x, r[b]);
+        return x;
+    }
+
+    bool blocVide(int li, int lj) const {
+        return S::vide(joindreBandes(resume.data() + ((long)li * d->colonnes + lj) * bandes));
+    }
+};
+
+/* Requêtes d'une diffusion non bloquante des panneaux : ligne, colonne,
+ * successeurs de la colonne, résumés de la ligne et de la colonne */
+static const int NB_REQUETES_PANNEAUX = 5;
+
+/* Blocs à traiter par majReste */
+enum FiltreBlocs { TOUS_BLOCS, PANNEAUX_SUIVANTS, SAUF_PANNEAUX_SUIVANTS };
+
+/* Phases 1 à 3 de l'étape K, pour les processus de la ligne ou de la colonne
+ * de processus qui possèdent la ligne/colonne de blocs K : fermeture du pivot,
+ * diffusion du pivot le long de cette ligne et de cette colonne, puis mise à
+ * jour des blocs [K, J] et [I, K] locaux.
+ */
+template<typename S>
+static void etapePanneaux(Moteur<S>& m, int K) {
+    typedef typename S::T T;
+    const Distribution& d = *m.d;
+    int kr = K % d.g.pr, kc = K % d.g.pc;
+    int lr = K / d.g.pr, lc = K / d.g.pc;
+    bool sur_ligne = (d.g.px == kr);
+    bool sur_colonne = (d.g.py == kc);
+    double t0 = MPI_Wtime();
+
+    int* N = m.N_local;
+
+    // ======== PHASE 1 : Calcul du bloc pivot [K,K] ========
+    T* piv = m.pivot;
+    int* pivN = m.pivotN;
+    if(sur_ligne && sur_colonne){
+        // Floyd-Warshall par sous-tuiles sur le bloc diagonal
+        piv = m.bloc(m.D_local, m.bb, lr, lc);
+        pivN = N ? m.bloc(N, m.bbN, lr, lc) : nullptr;
+        fermerBloc(S(), piv, pivN, d.nb);
+        if(m.saut) m.resumerBloc(lr, lc);
+    }
+    if(m.temps){
+        m.compter(PHASE_PANNEAUX, K, t0);
+        t0 = MPI_Wtime();
+    }
+
+    // Le pivot n'est utile qu'à la ligne et à la colonne de processus K ;
+    // ses successeurs ne servent qu'à la ligne (phase 2)
+    if(sur_ligne){
+        MPI_Bcast(piv, m.bb, typeMPI<T>(), kc, d.g.ligne);
+        if(N) MPI_Bcast(pivN, m.bbN, MPI_INT, kc, d.g.ligne);
+    }
+    if(sur_colonne)
+        MPI_Bcast(piv, m.bb, typeMPI<T>(), kr, d.g.colonne);
+    if(m.temps){
+        m.compter(PHASE_DIFFUSION, K, t0);
+        t0 = MPI_Wtime();
+    }
+
+    // ======== PHASE 2 : Mise à jour blocs LIGNE K ========
+    // Un bloc vide le reste : P ⊗ neutre = neutre
+    if(sur_ligne)
+        for(int lj=0; lj<d.colonnes; lj++){
+            if(blocGlobalColonne(d, lj) == K || (m.saut && m.blocVide(lr, lj))) continue;
+            majLignePivot(S(), m.bloc(m.D_local, m.bb, lr, lj),
+                          N ? m.bloc(N, m.bbN, lr, lj) : nullptr, piv, pivN, d.nb);
+            if(m.saut) m.resumerBloc(lr, lj);
+        }
+
+    // ======== PHASE 3 : Mise à jour blocs COLONNE K ========
+    if(sur_colonne)
+        for(int li=0; li<d.lignes; li++){
+            if(blocGlobalLigne(d, li) == K || (m.saut && m.blocVide(li, lc))) continue;
+            majColonnePivot(S(), m.bloc(m.D_local, m.bb, li, lc),
+                            N ? m.bloc(N, m.bbN, li, lc) : nullptr, piv, d.nb);
+            if(m.saut) m.resumerBloc(li, lc);
+        }
+    if(m.temps) m.compter(PHASE_PANNEAUX, K, t0);
+}
+
+/* Phase 4 de l'étape K : la ligne de blocs K est diffusée le long des colonnes
+ * de la grille (depuis D_local, contiguë), la colonne de blocs K le long des
+ * lignes (depuis D_local avec le type dérivé type_colonne). L'élément diffusé
+ * est toujours un bloc entier, des deux côtés : Open MPI découpe les grosses
+ * diffusions en segments d'après le type de chaque processus, et des types
+ * de tailles différentes à la racine et chez les récepteurs désynchronisent
+ * ce découpage. Avec les successeurs, ceux de la colonne de blocs K suivent
+ * le même chemin, avec leurs propres types puisque les poids ne sont pas
+ * forcément des int (ceux de la ligne K sont inutiles en phase 5). Diffusions
+ * bloquantes si req est nul, sinon MPI_Ibcast dont les requêtes sont rangées
+ * dans req[0..4] (les deux dernières pour les résumés).
+ *
+ * Avec les sauts de tuiles, les résumés des bandes des panneaux partent
+ * d'abord (resume_ligne, resume_colonne) ; en diffusion bloquante, seuls les
+ * blocs non vides suivent, que les récepteurs connaissent alors aussi. Les
+ * blocs vides reçus gardent leur contenu d'une étape précédente : la phase 5
+ * ne les lit pas, puisque sansEffet est vrai dès qu'un opérande est vide. En
+ * MPI_Ibcast, les panneaux sont diffusés entiers sans attendre les résumés.
+ */
+
+/* Diffuse, parmi les nblocs blocs d'un panneau, ceux dont le résumé n'est
+ * pas vide : chaque côté décrit ces blocs par un type indexé sur son propre
+ * type de bloc (même signature, un bloc entier par élément) */
+template<typename S>
+static void diffuserBlocsNonVides(Moteur<S>& m, void* X, int nblocs, const Resume<typename S::T>* r,
+                                  MPI_Datatype type, int racine, MPI_Comm comm) {
+    vector<int> depl;
+    for(int x=0; x<nblocs; x++)
+        if(!S::vide(m.joindreBandes(r + (long)x*m.bandes))) depl.push_back(x);
+    if(m.temps) m.temps->blocs_non_diffuses += nblocs - (long)depl.size();
+    if(depl.empty()) return;
+    if((int)depl.size() == nblocs){
+        MPI_Bcast(X, nblocs, type, racine, comm);
+        return;
+    }
+    MPI_Datatype choisis;
+    MPI_Type_create_indexed_block((int)depl.size(), 1, depl.data(), type, &choisis);
+    MPI_Type_commit(&choisis);
+    MPI_Bcast(X, 1, choisis, racine, comm);
+    MPI_Type_free(&choisis);
+}
+
+template<typename S>
+static void diffuserPanneaux(Moteur<S>& m, int K, int tampon, MPI_Request* req) {
+    typedef typename S::T T;
+    const Distribution& d = *m.d;
+    int kr = K % d.g.pr, kc = K % d.g.pc;
+    bool sur_ligne = (d.g.px == kr);
+    bool sur_colonne = (d.g.py == kc);
+
+    T* ligne_k = sur_ligne ? m.bloc(m.D_local, m.bb, K / d.g.pr, 0) : m.ligne_k[tampon];
+    T* colonne_k = m.colonne_k[tampon];
+    int* colonneN_k = m.colonneN_k[tampon];
+    MPI_Datatype type = m.type_bloc, typeN = m.type_blocN;
+    if(sur_colonne){
+        colonne_k = m.bloc(m.D_local, m.bb, 0, K / d.g.pc);
+        if(m.N_local) colonneN_k = m.bloc(m.N_local, m.bbN, 0, K / d.g.pc);
+        type = m.type_colonne;
+        typeN = m.type_colonneN;
+    }
+
+    // Résumés des panneaux, recopiés par leurs propriétaires
+    Resume<T>* r_ligne = m.saut ? m.resume_ligne[tampon].data() : nullptr;
+    Resume<T>* r_colonne = m.saut ? m.resume_colonne[tampon].data() : nullptr;
+    int octets_ligne = (int)(d.colonnes * m.bandes * sizeof(Resume<T>));
+    int octets_colonne = (int)(d.lignes * m.bandes * sizeof(Resume<T>));
+    if(m.saut && sur_ligne)
+        copy(m.resume.begin() + (long)(K / d.g.pr) * d.colonnes * m.bandes,
+             m.resume.begin() + (long)(K / d.g.pr + 1) * d.colonnes * m.bandes, r_ligne);
+    if(m.saut && sur_colonne)
+        for(int li=0; li<d.lignes; li++)
+            copy_n(m.resume.begin() + ((long)li * d.colonnes + K / d.g.pc) * m.bandes,
+                   m.bandes, r_colonne + (long)li * m.bandes);
+
+    double t0 = MPI_Wtime();
+    if(req == nullptr && m.temps && m.temps->synchroniser){
+        // Attente des processus en retard, séparée du transfert
+        MPI_Barrier(d.g.grille);
+        m.compter(PHASE_ATTENTE, K, t0);
+        t0 = MPI_Wtime();
+    }
+    if(req == nullptr && m.saut){
+        MPI_Bcast(r_ligne, octets_ligne, MPI_BYTE, kr, d.g.colonne);
+        MPI_Bcast(r_colonne, octets_colonne, MPI_BYTE, kc, d.g.ligne);
+        diffuserBlocsNonVides(m, ligne_k, d.colonnes, r_ligne, m.type_bloc, kr, d.g.colonne);
+        diffuserBlocsNonVides(m, colonne_k, d.lignes, r_colonne, type, kc, d.g.ligne);
+        if(m.N_local)
+            diffuserBlocsNonVides(m, colonneN_k, d.lignes, r_colonne, typeN, kc, d.g.ligne);
+    } else if(req == nullptr){
+        MPI_Bcast(ligne_k, d.colonnes, m.type_bloc, kr, d.g.colonne);
+        MPI_Bcast(colonne_k, d.lignes, type, kc, d.g.ligne);
+        if(m.N_local)
+            MPI_Bcast(colonneN_k, d.lignes, typeN, kc, d.g.ligne);
+    } else {
+        MPI_Ibcast(ligne_k, d.colonnes, m.type_bloc, kr, d.g.colonne, &req[0]);
+        MPI_Ibcast(colonne_k, d.lignes, type, kc, d.g.ligne, &req[1]);
+        req[2] = req[3] = req[4] = MPI_REQUEST_NULL;
+        if(m.N_local)
+            MPI_Ibcast(colonneN_k, d.lignes, typeN, kc, d.g.ligne, &req[2]);
+        if(m.saut){
+            MPI_Ibcast(r_ligne, octets_ligne, MPI_BYTE, kr, d.g.colonne, &req[3]);
+            MPI_Ibcast(r_colonne, octets_colonne, MPI_BYTE, kc, d.g.ligne, &req[4]);
+        }
+    }
+    if(m.temps) m.compter(PHASE_DIFFUSION, K, t0);
+}
+
+/* Phase 5 de l'étape K sur les blocs locaux retenus par le filtre :
+ * C[I][J] = min(C[I][J], C[I][K] ⊗ C[K][J]). Le travail est découpé en
+ * (bloc, bande de lignes) pour occuper tous les threads, qu'il y ait un seul
+ * gros bloc local ou beaucoup de petits. Si req est non nul, le travail est
+ * fait en plusieurs tranches entre lesquelles MPI_Testall fait progresser
+ * les diffusions non bloquantes en cours.
+ */
+template<typename S>
+static void majReste(Moteur<S>& m, int K, int tampon, FiltreBlocs filtre, MPI_Request* req) {
+    typedef typename S::T T;
+    const Distribution& d = *m.d;
+    int kr = K % d.g.pr, kc = K % d.g.pc;
+    int nb = d.nb;
+    int K1 = K + 1;
+    double t0 = MPI_Wtime();
+
+    struct Travail { T* C; int* NC; const T* A; const int* NA; const T* B; int i0, h, li, lj; };
+    vector<Travail> travaux;
+    long sautees = 0;
+    for(int li=0; li<d.lignes; li++){
+        int I = blocGlobalLigne(d, li);
+        if(I == K) continue;
+        const T* A = (d.g.py == kc) ? m.bloc(m.D_local, m.bb, li, K / d.g.pc)
+                                    : m.colonne_k[tampon] + (long)li*m.bb;
+        const int* NA = nullptr;
+        if(m.N_local)
+            NA = (d.g.py == kc) ? m.bloc(m.N_local, m.bbN, li, K / d.g.pc)
+                                : m.colonneN_k[tampon] + (long)li*m.bbN;
+        const Resume<T>* rA = m.saut ? m.resume_colonne[tampon].data() + (long)li*m.bandes : nullptr;
+        for(int lj=0; lj<d.colonnes; lj++){
+            int J = blocGlobalColonne(d, lj);
+            if(J == K) continue;
+            bool suivant = (I == K1 || J == K1);
+            if(filtre == PANNEAUX_SUIVANTS && !suivant) continue;
+            if(filtre == SAUF_PANNEAUX_SUIVANTS && suivant) continue;
+            const T* B = (d.g.px == kr) ? m.bloc(m.D_local, m.bb, K / d.g.pr, lj)
+                                        : m.ligne_k[tampon] + (long)lj*m.bb;
+            T* C = m.bloc(m.D_local, m.bb, li, lj);
+            int* NC = m.N_local ? m.bloc(m.N_local, m.bbN, li, lj) : nullptr;
+            // Bande de C sautée si les résumés de la bande de A, du bloc B
+            // et de la bande de C montrent qu'aucun élément ne peut changer
+            Resume<T> rB = Resume<T>();
+            const Resume<T>* rC = nullptr;
+            if(m.saut){
+                rB = m.joindreBandes(m.resume_ligne[tampon].data() + (long)lj*m.bandes);
+                rC = m.resume.data() + ((long)li*d.colonnes + lj)*m.bandes;
+            }
+            for(int i0=0, b=0; i0<nb; i0+=FLOYD_SOUS_TUILE, b++){
+                if(m.saut && S::sansEffet(rA[b], rB, rC[b])){
+                    sautees++;
+                    continue;
+                }
+                travaux.push_back({C, NC, A, NA, B, i0, min(FLOYD_SOUS_TUILE, nb-i0), li, lj});
+            }
+        }
+    }
+    if(m.temps){
+        m.temps->bandes_sautees += sautees;
+        m.temps->bandes_calculees += (long)travaux.size();
+    }
+
+    int nt = (int)travaux.size();
+    int tranches = (req != nullptr) ? 4 : 1;
+    for(int t=0; t<tranches; t++){
+        int debut = nt*t/tranches, fin = nt*(t+1)/tranches;
+        #pragma omp parallel for schedule(dynamic)
+        for(int w=debut; w<fin; w++){
+            const Travail& x = travaux[w];
+            long l = (long)x.i0*m.w, lN = (long)x.i0*nb;
+            majBande(S(), x.C + l, x.NC ? x.NC + lN : nullptr, x.A + l,
+                     x.NA ? x.NA + lN : nullptr, x.B, x.h, nb);
+            if(m.saut) m.resumerBande(x.li, x.lj, x.i0 / FLOYD_SOUS_TUILE);
+        }
+        if(req != nullptr){
+            int fini;
+            MPI_Testall(NB_REQUETES_PANNEAUX, req, &fini, MPI_STATUSES_IGNORE);
+        }
+    }
+    if(m.temps) m.compter(PHASE_RESTE, K, t0);
+}
+
+/* Variante avec anticipation, sur les étapes [K0, K1) : les processus qui
+ * possèdent des blocs de la ligne ou de la colonne K+1 mettent d'abord ces
+ * blocs à jour pour l'étape K, calculent les panneaux K+1 et lancent leur
+ * diffusion (MPI_Ibcast), puis terminent le reste de l'étape K pendant le
+ * transfert. Les autres processus postent la réception des panneaux K+1
+ * avant leur phase 5 de l'étape K. Les panneaux reçus alternent entre deux
+ * tampons. Rien n'est anticipé au-delà de K1 : les blocs sont alors dans
+ * l'état exact de la fin de l'étape K1-1.
+ */
+template<typename S>
+static void floydAnticipation(Moteur<S>& m, int K0, int K1) {
+    const Distribution& d = *m.d;
+    MPI_Request req[2][NB_REQUETES_PANNEAUX];
+
+    // Prologue : panneaux de l'étape K0
+    if(d.g.px == K0 % d.g.pr || d.g.py == K0 % d.g.pc)
+        etapePanneaux(m, K0);
+    diffuserPanneaux(m, K0, 0, req[0]);
+
+    for(int K=K0; K<K1; K++){
+        int cur = (K-K0)%2, suiv = (K-K0+1)%2;
+        double t0 = MPI_Wtime();
+        MPI_Waitall(NB_REQUETES_PANNEAUX, req[cur], MPI_STATUSES_IGNORE);
+        if(m.temps) m.compter(PHASE_DIFFUSION, K, t0);
+
+        bool a_suivre = (K+1 < K1);
+        bool critique = a_suivre && (d.g.px == (K+1) % d.g.pr || d.g.py == (K+1) % d.g.pc);
+        fill_n(req[suiv], NB_REQUETES_PANNEAUX, MPI_REQUEST_NULL);
+
+        if(critique){
+            // Chemin critique : blocs K+1 de l'étape K, puis panneaux K+1 au plus tôt
+            majReste(m, K, cur, PANNEAUX_SUIVANTS, nullptr);
+            etapePanneaux(m, K+1);
+            diffuserPanneaux(m, K+1, suiv, req[suiv]);
+            majReste(m, K, cur, SAUF_PANNEAUX_SUIVANTS, req[suiv]);
+        } else {
+            if(a_suivre)
+                diffuserPanneaux(m, K+1, suiv, req[suiv]);
+            majReste(m, K, cur, TOUS_BLOCS, a_suivre ? req[suiv] : nullptr);
+        }
+    }
+}
+
+/* Points de reprise : en-tête de 64 octets, puis les blocs de chaque
+ * processus dans l'ordre des rangs, puis leurs successeurs */
+struct EntetePointReprise {
+    char magie[8];          // "FLOYDPR1"
+    int32_t semi_anneau;    // codeSemiAnneau
+    int32_t taille_elem;    // sizeof(T)
+    int32_t flottant;       // T flottant
+    int32_t n, nb, pr, pc;
+    int32_t k;              // prochaine étape
+    int32_t successeurs;    // successeurs présents
+    int32_t reserve;
+    int64_t taille;         // octets du fichier
+    uint64_t empreinte;     // empreinte des blocs initiaux (graphe d'entrée)
+};
+static const char MAGIE_REPRISE[8] = {'F','L','O','Y','D','P','R','1'};
+
+template<typename P> static int codeSemiAnneau(MinPlus<P>) { return 1; }
+template<typename P> static int codeSemiAnneau(MaxMin<P>) { return 2; }
+static int codeSemiAnneau(Accessibilite) { return 3; }
+
+/* Empreinte des blocs de départ, identique sur tous les processus
+ * (collectif) : FNV-1a de chaque bloc local, mélangé avec son numéro
+ * global puis sommé sur la grille. Deux graphes de même taille donnent
+ * presque sûrement des empreintes différentes. */
+template<typename S>
+static uint64_t empreinteBlocs(const Moteur<S>& m) {
+    typedef typename S::T T;
+    const Distribution& d = *m.d;
+    uint64_t somme = 0;
+    #pragma omp parallel for collapse(2) reduction(+:somme)
+    for(int li=0; li<d.lignes; li++)
+        for(int lj=0; lj<d.colonnes; lj++){
+            const unsigned char* o = (const unsigned char*)m.bloc(m.D_local, m.bb, li, lj);
+            uint64_t h = 1469598103934665603ULL;
+            for(long x=0; x<(long)m.bb*(long)sizeof(T); x++){
+                h ^= o[x];
+                h *= 1099511628211ULL;
+            }
+            // splitmix64 de (h, I, J) : une permutation des blocs change l'empreinte
+            uint64_t z = h + 0x9E3779B97F4A7C15ULL *
+                ((uint64_t)blocGlobalLigne(d, li) * d.nblocs + blocGlobalColonne(d, lj) + 1);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            somme += z ^ (z >> 31);
+        }
+    MPI_Allreduce(MPI_IN_PLACE, &somme, 1, MPI_UINT64_T, MPI_SUM, d.g.grille);
+    return somme;
+}
+
+/* En-tête attendu pour l'étape K et positions (en octets) des blocs et des
+ * successeurs de ce processus dans le fichier */
+template<typename S>
+static EntetePointReprise entetePointReprise(const Moteur<S>& m, int K,
+                                             MPI_Offset* pos_D, MPI_Offset* pos_N) {
+    typedef typename S::T T;
+    const Distribution& d = *m.d;
+    long long nblocs_loc = (long long)d.lignes * d.colonnes;
+    long long octets[2] = {nblocs_loc * m.bb * (long long)sizeof(T),
+                           m.N_local ? nblocs_loc * m.bbN * (long long)sizeof(int) : 0};
+    long long avant[2] = {0, 0}, total[2];
+    int rang;
+    MPI_Comm_rank(d.g.grille, &rang);
+    MPI_Exscan(octets, avant, 2, MPI_LONG_LONG, MPI_SUM, d.g.grille);
+    MPI_Allreduce(octets, total, 2, MPI_LONG_LONG, MPI_SUM, d.g.grille);
+    if(rang == 0) avant[0] = avant[1] = 0;
+
+    EntetePointReprise e;
+    memset(&e, 0, sizeof(e));
+    memcpy(e.magie, MAGIE_REPRISE, 8);
+    e.semi_anneau = codeSemiAnneau(S());
+    e.taille_elem = sizeof(T);
+    e.flottant = !numeric_limits<T>::is_integer;
+    e.n = d.n; e.nb = d.nb; e.pr = d.g.pr; e.pc = d.g.pc;
+    e.k = K;
+    e.successeurs = (m.N_local != nullptr);
+    e.empreinte = m.empreinte;
+    e.taille = sizeof(e) + total[0] + total[1];
+    *pos_D = sizeof(e) + avant[0];
+    *pos_N = sizeof(e) + total[0] + avant[1];
+    return e;
+}
+
+/* Écrit l'état de la fin de l'étape K-1 dans fichier.tmp (collectif), puis
+ * le root le renomme en fichier. Un échec n'interrompt pas le calcul. */
+template<typename S>
+static void ecrirePointReprise(Moteur<S>& m, PointReprise* rep, int K) {
+    const Distribution& d = *m.d;
+    double t0 = MPI_Wtime();
+    MPI_Offset pos_D, pos_N;
+    EntetePointReprise e = entetePointReprise(m, K, &pos_D, &pos_N);
+    int nblocs_loc = d.lignes * d.colonnes;
+    int rang;
+    MPI_Comm_rank(d.g.grille, &rang);
+
+    string tmp = string(rep->fichier) + ".tmp";
+    MPI_File fh;
+    int ok = MPI_File_open(d.g.grille, tmp.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                           MPI_INFO_NULL, &fh) == MPI_SUCCESS;
+    if(ok){
+        ok = MPI_File_set_size(fh, e.taille) == MPI_SUCCESS;
+        if(rang == 0)
+            ok &= MPI_File_write_at(fh, 0, &e, sizeof(e), MPI_BYTE, MPI_STATUS_IGNORE) == MPI_SUCCESS;
+        ok &= MPI_File_write_at_all(fh, pos_D, m.D_local, nblocs_loc, m.type_bloc,
+                                    MPI_STATUS_IGNORE) == MPI_SUCCESS;
+        if(m.N_local)
+            ok &= MPI_File_write_at_all(fh, pos_N, m.N_local, nblocs_loc, m.type_blocN,
+                                        MPI_STATUS_IGNORE) == MPI_SUCCESS;
+        ok &= MPI_File_close(&fh) == MPI_SUCCESS;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, d.g.grille);
+    if(rang == 0 && ok)
+        ok = rename(tmp.c_str(), rep->fichier) == 0;
+    // Personne ne rouvre fichier.tmp avant la fin du renommage
+    MPI_Bcast(&ok, 1, MPI_INT, 0, d.g.grille);
+    if(ok){
+        rep->ecritures++;
+        rep->octets = e.taille;
+    } else if(rang == 0)
+        cerr << "Attention : point de reprise " << rep->fichier << " non écrit (étape "
+             << K << ")" << endl;
+    rep->temps_ecriture += MPI_Wtime() - t0;
+}
+
+/* Relit un point de reprise compatible dans les blocs (collectif) ; rend
+ * l'étape à reprendre, 0 si le fichier est absent ou incompatible (blocs
+ * inchangés) */
+template<typename S>
+static int lirePointReprise(Moteur<S>& m, PointReprise* rep) {
+    const Distribution& d = *m.d;
+    double t0 = MPI_Wtime();
+    MPI_Offset pos_D, pos_N;
+    EntetePointReprise attendu = entetePointReprise(m, 0, &pos_D, &pos_N);
+    int nblocs_loc = d.lignes * d.colonnes;
+    int rang;
+    MPI_Comm_rank(d.g.grille, &rang);
+
+    MPI_File fh;
+    if(MPI_File_open(d.g.grille, rep->fichier, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS){
+        if(rang == 0)
+            cerr << "Point de reprise " << rep->fichier << " absent : départ à l'étape 0" << endl;
+        return 0;
+    }
+    EntetePointReprise e;
+    MPI_Offset taille = 0;
+    MPI_File_get_size(fh, &taille);
+    if(rang == 0 && MPI_File_read_at(fh, 0, &e, sizeof(e), MPI_BYTE, MPI_STATUS_IGNORE) != MPI_SUCCESS)
+        memset(&e, 0, sizeof(e));
+    MPI_Bcast(&e, sizeof(e), MPI_BYTE, 0, d.g.grille);
+
+    attendu.k = e.k;
+    bool meme_graphe = e.empreinte == attendu.empreinte;
+    attendu.empreinte = e.empreinte;
+    bool valide = memcmp(&e, &attendu, sizeof(e)) == 0 && taille >= e.taille
+                  && e.k > 0 && e.k <= d.nblocs;
+    if(valide && !meme_graphe){
+        // Même format, autre graphe : reprendre donnerait des distances fausses
+        if(rang == 0)
+            cerr << "Point de reprise " << rep->fichier << " calculé sur un autre graphe"
+                 << " (empreinte différente) : départ à l'étape 0" << endl;
+        MPI_File_close(&fh);
+        rep->temps_lecture += MPI_Wtime() - t0;
+        return 0;
+    }
+    int k = 0;
+    if(valide){
+        int ok = MPI_File_read_at_all(fh, pos_D, m.D_local, nblocs_loc, m.type_bloc,
+                                      MPI_STATUS_IGNORE) == MPI_SUCCESS;
+        if(m.N_local)
+            ok &= MPI_File_read_at_all(fh, pos_N, m.N_local, nblocs_loc, m.type_blocN,
+                                       MPI_STATUS_IGNORE) == MPI_SUCCESS;
+        MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, d.g.grille);
+        if(!ok){
+            // Blocs partiellement relus : l'état initial est perdu
+            if(rang == 0)
+                cerr << "Erreur : lecture du point de reprise " << rep->fichier << endl;
+            MPI_Abort(d.g.grille, 1);
+        }
+        k = e.k;
+    } else if(rang == 0)
+        cerr << "Point de reprise " << rep->fichier << " incompatible (n, bloc, grille, type,"
+             << " semi-anneau ou successeurs) : départ à l'étape 0" << endl;
+    MPI_File_close(&fh);
+    rep->temps_lecture += MPI_Wtime() - t0;
+    return k;
+}
+
 /**
- * @brief Floyd-Warshall par blocs avec MPI et OpenMP
+ * @brief Fermeture par blocs avec MPI et OpenMP, pour le semi-anneau S
  */
-int* floydBlocsHybrid(int* D_local, int nb_nodes, int p_sqrt, int pid, int root, int num_threads){
-    int block_size = nb_nodes/p_sqrt;
-    int px = pid/p_sqrt;   // Position ligne du processus dans la grille
-    int py = pid%p_sqrt;   // Position colonne du processus dans la grille
-    omp_set_num_threads(num_threads);
-    int* pivot = new int[block_size*block_size];
-    int* row_block = new int[block_size*block_size];
-    int* col_block = new int[block_size*block_size];
-
-    // Pour chaque bloc diagonal (pivot)
-    for(int k=0; k<p_sqrt; k++){
-        int pivot_rank = k*p_sqrt + k;  // Processus qui possède le bloc diagonal
-
-        // ======== PHASE 1 : Calcul du bloc pivot [k,k] ========
-        if(pid == pivot_rank){
-            // Floyd-Warshall standard sur le bloc diagonal
-            #pragma omp parallel for collapse(2) 
-            for(int kk=0; kk<block_size; kk++){
-                for(int i=0; i<block_size; i++){
-                    for(int j=0; j<block_size; j++){
-                        if(A(D_local,block_size,i,kk) < INF && 
-                           A(D_local,block_size,kk,j) < INF){
-                            int new_dist = A(D_local,block_size,i,kk) + 
-                                         A(D_local,block_size,kk,j);
-                            if(new_dist < A(D_local,block_size,i,j)){
-                                A(D_local,block_size,i,j) = new_dist;
-                            }
-                        }
-                    }
+template<typename S>
+void fermetureBlocsLocal(typename S::T* X_local, const Distribution& dist,
+                         int num_threads, bool anticipation, int* N_local,
+                         PointReprise* reprise, TempsPhases* temps){
+    typedef typename S::T T;
+    if(num_threads > 0)
+        omp_set_num_threads(num_threads);
+
+    // Tampons de réception réutilisés à chaque étape
+    Moteur<S> m;
+    m.d = &dist;
+    m.D_local = X_local;
+    m.N_local = N_local;
+    m.temps = temps;
+    if(temps && temps->par_etape && temps->etapes.size() != (size_t)dist.nblocs*NB_PHASES)
+        temps->etapes.assign((size_t)dist.nblocs*NB_PHASES, 0.0);
+    m.w = S::mots(dist.nb);
+    m.bb = dist.nb*m.w;
+    m.bbN = dist.nb*dist.nb;
+    m.pivot = new T[m.bb];
+    m.pivotN = N_local ? new int[m.bbN] : nullptr;
+    for(int t=0; t<2; t++){
+        m.ligne_k[t] = new T[(long)dist.colonnes*m.bb];
+        m.colonne_k[t] = new T[(long)dist.lignes*m.bb];
+        m.colonneN_k[t] = N_local ? new int[(long)dist.lignes*m.bbN] : nullptr;
+    }
+    MPI_Type_contiguous(m.bb, typeMPI<T>(), &m.type_bloc);
+    MPI_Type_commit(&m.type_bloc);
+    MPI_Type_create_resized(m.type_bloc, 0, (MPI_Aint)dist.colonnes*m.bb*sizeof(T),
+                            &m.type_colonne);
+    MPI_Type_commit(&m.type_colonne);
+    MPI_Type_contiguous(m.bbN, MPI_INT, &m.type_blocN);
+    MPI_Type_commit(&m.type_blocN);
+    MPI_Type_create_resized(m.type_blocN, 0, (MPI_Aint)dist.colonnes*m.bbN*sizeof(int),
+                            &m.type_colonneN);
+    MPI_Type_commit(&m.type_colonneN);
+
+    // Étapes faites par tranches [K0, K1) entre deux points de reprise
+    int K0 = 0;
+    if(reprise){
+        reprise->ecritures = 0;
+        reprise->temps_ecriture = reprise->temps_lecture = 0;
+        reprise->octets = 0;
+        // Blocs encore initiaux : leur empreinte identifie le graphe d'entrée
+        m.empreinte = empreinteBlocs(m);
+        if(reprise->reprendre)
+            K0 = lirePointReprise(m, reprise);
+        reprise->k_depart = K0;
+    }
+
+    // Résumés des blocs de départ (éventuellement relus)
+    m.saut = FLOYD_SAUT_TUILES;
+    m.bandes = (dist.nb + FLOYD_SOUS_TUILE - 1) / FLOYD_SOUS_TUILE;
+    if(m.saut){
+        m.resume.resize((size_t)dist.lignes*dist.colonnes*m.bandes);
+        for(int t=0; t<2; t++){
+            m.resume_ligne[t].resize((size_t)dist.colonnes*m.bandes);
+            m.resume_colonne[t].resize((size_t)dist.lignes*m.bandes);
+        }
+        #pragma omp parallel for collapse(2) schedule(dynamic)
+        for(int li=0; li<dist.lignes; li++)
+            for(int lj=0; lj<dist.colonnes; lj++)
+                m.resumerBloc(li, lj);
+    }
+    int pas = (reprise && reprise->intervalle > 0) ? reprise->intervalle : dist.nblocs;
+    while(K0 < dist.nblocs){
+        int K1 = min(dist.nblocs, (K0 / pas + 1) * pas);
+        if(anticipation){
+            floydAnticipation(m, K0, K1);
+        } else {
+            // Pour chaque bloc diagonal (pivot)
+            for(int K=K0; K<K1; K++){
+                // ======== PHASES 1 à 3 : pivot, ligne K et colonne K ========
+                if(dist.g.px == K % dist.g.pr || dist.g.py == K % dist.g.pc)
+                    etapePanneaux(m, K);
+
+                // ======== PHASE 4 : Diffusion ligne K et colonne K ========
+                // Les collectives suffisent à synchroniser : pas de MPI_Barrier.
+                diffuserPanneaux(m, K, 0, nullptr);
+
+                // ======== PHASE 5 : Mise à jour AUTRES blocs ========
+                majReste(m, K, 0, TOUS_BLOCS, nullptr);
+            }
+        }
+        K0 = K1;
+        if(K0 < dist.nblocs && reprise && reprise->intervalle > 0)
+            ecrirePointReprise(m, reprise, K0);
+    }
+
+    MPI_Type_free(&m.type_colonneN);
+    MPI_Type_free(&m.type_blocN);
+    MPI_Type_free(&m.type_colonne);
+    MPI_Type_free(&m.type_bloc);
+    delete[] m.pivot;
+    delete[] m.pivotN;
+    for(int t=0; t<2; t++){
+        delete[] m.ligne_k[t];
+        delete[] m.colonne_k[t];
+        delete[] m.colonneN_k[t];
+    }
+}
+
+template<typename T>
+void floydBlocsLocal(T* D_local, const Distribution& dist,
+                     int num_threads, bool anticipation, int* N_local,
+                     PointReprise* reprise, TempsPhases* temps){
+    fermetureBlocsLocal<MinPlus<T> >(D_local, dist, num_threads, anticipation, N_local, reprise, temps);
+}
+
+template<typename T>
+T* floydBlocsHybrid(T* D_local, const Distribution& dist, int root,
+                    int num_threads, bool anticipation, int* N_local,
+                    PointReprise* reprise, TempsPhases* temps){
+    floydBlocsLocal(D_local, dist, num_threads, anticipation, N_local, reprise, temps);
+    return rassemblerMatrice(D_local, dist, root);
+}
+
+/* Fermeture par flot de données : état d'une étape K de la fenêtre */
+template<typename T>
+struct EtapeFlux {
+    T* pivot;                   // pivot reçu
+    T* ligne;                   // ligne de blocs K reçue (colonnes blocs)
+    T* colonne;                 // colonne de blocs K reçue (lignes blocs)
+    MPI_Request recu[3];        // réceptions du pivot, de la ligne et de la colonne
+    vector<MPI_Request> envois; // envois des blocs K locaux
+    int restants;               // tâches locales de l'étape non faites
+    bool ligne_envoyee, colonne_envoyee;
+};
+
+template<typename S>
+struct Flux {
+    typedef typename S::T T;
+    Moteur<S> m;                // distribution, blocs, types et temps
+    int fenetre;
+    int K_bas;                  // plus petite étape non terminée localement
+    vector<int> version;        // étapes appliquées à chaque bloc local
+    vector<EtapeFlux<T> > etapes;
+
+    EtapeFlux<T>& etape(int K) { return etapes[K % fenetre]; }
+    int& versionBloc(int li, int lj) { return version[li * m.d->colonnes + lj]; }
+    T* bloc(int li, int lj) const { return m.bloc(m.D_local, m.bb, li, lj); }
+
+    /* Le bloc (I, J) peut-il être réécrit à l'étape K : les étapes I et J,
+     * qui le lisent comme panneau, doivent être terminées */
+    bool libre(int I, int J, int K) const {
+        return !(I < K && I >= K_bas) && !(J < K && J >= K_bas);
+    }
+};
+
+/* Étiquettes des messages : (pivot, ligne, colonne) de l'étape K. Au-delà
+ * de 30000 (MPI_TAG_UB vaut au moins 32767) elles reviennent à 0 ; les
+ * messages d'une même source arrivent dans l'ordre des étapes, comme les
+ * réceptions sont postées, et restent donc appariés. */
+static int etiquetteFlux(int K, int type) {
+    return (3*K + type) % 30000;
+}
+
+/* Ouvre l'étape K dans la fenêtre : réceptions du pivot et des panneaux
+ * dont le processus a besoin */
+template<typename S>
+static void ouvrirEtapeFlux(Flux<S>& f, int K) {
+    typedef typename S::T T;
+    const Distribution& d = *f.m.d;
+    int kr = K % d.g.pr, kc = K % d.g.pc;
+    EtapeFlux<T>& e = f.etape(K);
+    e.restants = d.lignes * d.colonnes;
+    e.envois.clear();
+    e.ligne_envoyee = e.colonne_envoyee = false;
+    e.recu[0] = e.recu[1] = e.recu[2] = MPI_REQUEST_NULL;
+    if(d.g.px == kr && d.g.py != kc)
+        MPI_Irecv(e.pivot, f.m.bb, typeMPI<T>(), kc, etiquetteFlux(K, 0), d.g.ligne, &e.recu[0]);
+    else if(d.g.py == kc && d.g.px != kr)
+        MPI_Irecv(e.pivot, f.m.bb, typeMPI<T>(), kr, etiquetteFlux(K, 0), d.g.colonne, &e.recu[0]);
+    if(d.g.px != kr)
+        MPI_Irecv(e.ligne, d.colonnes, f.m.type_bloc, kr, etiquetteFlux(K, 1), d.g.colonne, &e.recu[1]);
+    if(d.g.py != kc)
+        MPI_Irecv(e.colonne, d.lignes, f.m.type_bloc, kc, etiquetteFlux(K, 2), d.g.ligne, &e.recu[2]);
+}
+
+/* Tâches du pivot et des panneaux prêtes dans la fenêtre, exécutées tout
+ * de suite (chemin critique) ; chaque panneau complet part vers ses
+ * consommateurs. Rend vrai si une tâche a été faite. */
+template<typename S>
+static bool tachesPanneaux(Flux<S>& f) {
+    typedef typename S::T T;
+    const Distribution& d = *f.m.d;
+    int nb = d.nb;
+    bool fait = false;
+    for(int K=f.K_bas; K<min(d.nblocs, f.K_bas + f.fenetre); K++){
+        int kr = K % d.g.pr, kc = K % d.g.pc;
+        int lr = K / d.g.pr, lc = K / d.g.pc;
+        bool sur_ligne = (d.g.px == kr), sur_colonne = (d.g.py == kc);
+        if(!sur_ligne && !sur_colonne) continue;
+        EtapeFlux<T>& e = f.etape(K);
+        double t0 = MPI_Wtime();
+        bool fait_K = false;
+
+        // Pivot, envoyé à la ligne et à la colonne de processus K
+        if(sur_ligne && sur_colonne && f.versionBloc(lr, lc) == K && f.libre(K, K, K)){
+            fermerBloc(S(), f.bloc(lr, lc), nullptr, nb);
+            f.versionBloc(lr, lc)++;
+            e.restants--;
+            for(int y=0; y<d.g.pc; y++) if(y != kc){
+                e.envois.push_back(MPI_REQUEST_NULL);
+                MPI_Isend(f.bloc(lr, lc), f.m.bb, typeMPI<T>(), y, etiquetteFlux(K, 0), d.g.ligne, &e.envois.back());
+            }
+            for(int x=0; x<d.g.pr; x++) if(x != kr){
+                e.envois.push_back(MPI_REQUEST_NULL);
+                MPI_Isend(f.bloc(lr, lc), f.m.bb, typeMPI<T>(), x, etiquetteFlux(K, 0), d.g.colonne, &e.envois.back());
+            }
+            fait_K = true;
+        }
+        bool pivot_local = sur_ligne && sur_colonne;
+        bool a_pivot = pivot_local ? f.versionBloc(lr, lc) > K : e.recu[0] == MPI_REQUEST_NULL;
+        const T* piv = pivot_local ? f.bloc(lr, lc) : e.pivot;
+
+        if(sur_ligne && !e.ligne_envoyee){
+            bool complete = true;
+            for(int lj=0; lj<d.colonnes; lj++){
+                int& v = f.versionBloc(lr, lj);
+                int J = blocGlobalColonne(d, lj);
+                if(v == K && J != K && a_pivot && f.libre(K, J, K)){
+                    majLignePivot(S(), f.bloc(lr, lj), nullptr, piv, nullptr, nb);
+                    v++;
+                    e.restants--;
+                    fait_K = true;
                 }
+                complete = complete && v > K;
             }
-            copy(D_local, D_local+block_size*block_size, pivot);
-        }
-
-        // Broadcast du bloc pivot à tous les processus
-        MPI_Bcast(pivot, block_size*block_size, MPI_INT, pivot_rank, MPI_COMM_WORLD);
-
-        // ======== PHASE 2 : Mise à jour blocs LIGNE k ========
-        if(px == k && py != k){
-            // Je suis dans la ligne k mais pas sur la diagonale
-            #pragma omp parallel for collapse(2) 
-            for(int kk=0; kk<block_size; kk++){
-                for(int i=0; i<block_size; i++){
-                    for(int j=0; j<block_size; j++){
-                        if(pivot[i*block_size+kk] < INF && 
-                           A(D_local,block_size,kk,j) < INF){
-                            int new_dist = pivot[i*block_size+kk] + 
-                                         A(D_local,block_size,kk,j);
-                            if(new_dist < A(D_local,block_size,i,j)){
-                                A(D_local,block_size,i,j) = new_dist;
-                            }
-                        }
-                    }
+            if(complete){
+                for(int x=0; x<d.g.pr; x++) if(x != kr){
+                    e.envois.push_back(MPI_REQUEST_NULL);
+                    MPI_Isend(f.bloc(lr, 0), d.colonnes, f.m.type_bloc, x, etiquetteFlux(K, 1),
+                              d.g.colonne, &e.envois.back());
                 }
+                e.ligne_envoyee = true;
             }
         }
-        
-        // ======== PHASE 3 : Mise à jour blocs COLONNE k ========
-        if(py == k && px != k){
-            // Je suis dans la colonne k mais pas sur la diagonale
-            #pragma omp parallel for collapse(2) 
-            for(int kk=0; kk<block_size; kk++){
-                for(int i=0; i<block_size; i++){
-                    for(int j=0; j<block_size; j++){
-                        if(A(D_local,block_size,i,kk) < INF && 
-                           pivot[kk*block_size+j] < INF){
-                            int new_dist = A(D_local,block_size,i,kk) + 
-                                         pivot[kk*block_size+j];
-                            if(new_dist < A(D_local,block_size,i,j)){
-                                A(D_local,block_size,i,j) = new_dist;
-                            }
-                        }
-                    }
+        if(sur_colonne && !e.colonne_envoyee){
+            bool complete = true;
+            for(int li=0; li<d.lignes; li++){
+                int& v = f.versionBloc(li, lc);
+                int I = blocGlobalLigne(d, li);
+                if(v == K && I != K && a_pivot && f.libre(I, K, K)){
+                    majColonnePivot(S(), f.bloc(li, lc), nullptr, piv, nb);
+                    v++;
+                    e.restants--;
+                    fait_K = true;
+                }
+                complete = complete && v > K;
+            }
+            if(complete){
+                for(int y=0; y<d.g.pc; y++) if(y != kc){
+                    e.envois.push_back(MPI_REQUEST_NULL);
+                    MPI_Isend(f.bloc(0, lc), d.lignes, f.m.type_colonne, y, etiquetteFlux(K, 2),
+                              d.g.ligne, &e.envois.back());
                 }
+                e.colonne_envoyee = true;
             }
         }
+        if(fait_K && f.m.temps) f.m.compter(PHASE_PANNEAUX, K, t0);
+        fait = fait || fait_K;
+    }
+    return fait;
+}
 
-        // Synchronisation avant de broadcaster ligne et colonne
-        MPI_Barrier(MPI_COMM_WORLD);
+/* Mises à jour C[I][J] ⊕= C[I][K] ⊗ C[K][J] prêtes pour la plus petite
+ * étape K qui en a, par bandes de lignes sur les threads ; celles des
+ * blocs des panneaux K+1 passent seules en premier. Rend vrai si des
+ * tâches ont été faites. */
+template<typename S>
+static bool tachesReste(Flux<S>& f) {
+    typedef typename S::T T;
+    const Distribution& d = *f.m.d;
+    int nb = d.nb;
+    struct Travail { T* C; const T* A; const T* B; int i0, h; };
+    vector<Travail> travaux;
+    vector<int*> versions;
+    for(int K=f.K_bas; K<min(d.nblocs, f.K_bas + f.fenetre) && versions.empty(); K++){
+        int kr = K % d.g.pr, kc = K % d.g.pc;
+        EtapeFlux<T>& e = f.etape(K);
+        for(int critique=1; critique>=0 && versions.empty(); critique--)
+            for(int li=0; li<d.lignes; li++){
+                int I = blocGlobalLigne(d, li);
+                if(I == K) continue;
+                bool a_colonne = (d.g.py == kc) ? f.versionBloc(li, K / d.g.pc) > K
+                                                : e.recu[2] == MPI_REQUEST_NULL;
+                if(!a_colonne) continue;
+                const T* A = (d.g.py == kc) ? f.bloc(li, K / d.g.pc) : e.colonne + (long)li*f.m.bb;
+                for(int lj=0; lj<d.colonnes; lj++){
+                    int J = blocGlobalColonne(d, lj);
+                    int& v = f.versionBloc(li, lj);
+                    if(J == K || v != K || (I == K+1 || J == K+1) != (critique == 1)) continue;
+                    bool a_ligne = (d.g.px == kr) ? f.versionBloc(K / d.g.pr, lj) > K
+                                                  : e.recu[1] == MPI_REQUEST_NULL;
+                    if(!a_ligne || !f.libre(I, J, K)) continue;
+                    const T* B = (d.g.px == kr) ? f.bloc(K / d.g.pr, lj) : e.ligne + (long)lj*f.m.bb;
+                    for(int i0=0; i0<nb; i0+=FLOYD_SOUS_TUILE)
+                        travaux.push_back({f.bloc(li, lj), A, B, i0, min(FLOYD_SOUS_TUILE, nb-i0)});
+                    versions.push_back(&v);
+                }
+            }
+        if(versions.empty()) continue;
 
-        // ======== PHASE 4 : Broadcast ligne k et colonne k ========
-        // Chaque processus a besoin de deux blocs :
-        // - Le bloc [k, py] (dans la ligne k, colonne py)
-        // - Le bloc [px, k] (dans la ligne px, colonne k)
-        
-        // Broadcast de tous les blocs de la ligne k
-        for(int col=0; col<p_sqrt; col++){
-            int source = k*p_sqrt + col;  // Processus [k, col]
-            
-            int* temp_buf = new int[block_size*block_size];
-            if(pid == source){
-                copy(D_local, D_local+block_size*block_size, temp_buf);
-            }
-            MPI_Bcast(temp_buf, block_size*block_size, MPI_INT, source, MPI_COMM_WORLD);
-            
-            // Si c'est le bloc dont j'ai besoin, je le garde
-            if(col == py){
-                copy(temp_buf, temp_buf+block_size*block_size, row_block);
-            }
-            delete[] temp_buf;
-        }
-        
-        // Broadcast de tous les blocs de la colonne k
-        for(int row=0; row<p_sqrt; row++){
-            int source = row*p_sqrt + k;  // Processus [row, k]
-            
-            int* temp_buf = new int[block_size*block_size];
-            if(pid == source){
-                copy(D_local, D_local+block_size*block_size, temp_buf);
-            }
-            MPI_Bcast(temp_buf, block_size*block_size, MPI_INT, source, MPI_COMM_WORLD);
-            
-            // Si c'est le bloc dont j'ai besoin, je le garde
-            if(row == px){
-                copy(temp_buf, temp_buf+block_size*block_size, col_block);
-            }
-            delete[] temp_buf;
+        double t0 = MPI_Wtime();
+        int nt = (int)travaux.size();
+        #pragma omp parallel for schedule(dynamic)
+        for(int t=0; t<nt; t++){
+            const Travail& x = travaux[t];
+            long l = (long)x.i0*f.m.w;
+            majBande(S(), x.C + l, nullptr, x.A + l, nullptr, x.B, x.h, nb);
         }
+        for(int* v : versions) (*v)++;
+        e.restants -= (int)versions.size();
+        if(f.m.temps) f.m.compter(PHASE_RESTE, K, t0);
+    }
+    return !versions.empty();
+}
 
-        MPI_Barrier(MPI_COMM_WORLD);
+/* Referme les étapes terminées (tâches, réceptions et envois) à partir de
+ * K_bas et ouvre les suivantes ; rend vrai si K_bas a avancé */
+template<typename S>
+static bool fermerEtapesFlux(Flux<S>& f) {
+    typedef typename S::T T;
+    const Distribution& d = *f.m.d;
+    int K0 = f.K_bas;
+    while(f.K_bas < d.nblocs){
+        EtapeFlux<T>& e = f.etape(f.K_bas);
+        bool termine = e.restants == 0;
+        for(int t=0; t<3; t++) termine = termine && e.recu[t] == MPI_REQUEST_NULL;
+        for(MPI_Request& r : e.envois) termine = termine && r == MPI_REQUEST_NULL;
+        if(!termine) break;
+        int suivante = f.K_bas + f.fenetre;
+        f.K_bas++;
+        if(suivante < d.nblocs) ouvrirEtapeFlux(f, suivante);
+    }
+    return f.K_bas > K0;
+}
+
+/* Fait progresser les communications de la fenêtre ; si attendre, que rien
+ * n'est arrivé et qu'aucune étape ne se termine, bloque jusqu'à la fin de
+ * l'une d'elles.
+ * Puis referme les étapes terminées. */
+template<typename S>
+static void progresserFlux(Flux<S>& f, bool attendre) {
+    typedef typename S::T T;
+    const Distribution& d = *f.m.d;
+    double t0 = MPI_Wtime();
+    vector<MPI_Request*> attente;
+    bool arrive = false;        // une réception a pu rendre des tâches prêtes
+    for(int K=f.K_bas; K<min(d.nblocs, f.K_bas + f.fenetre); K++){
+        EtapeFlux<T>& e = f.etape(K);
+        for(int t=0; t<3; t++){
+            int fini = 1;
+            if(e.recu[t] != MPI_REQUEST_NULL){
+                MPI_Test(&e.recu[t], &fini, MPI_STATUS_IGNORE);
+                arrive = arrive || fini;
+            }
+            if(!fini) attente.push_back(&e.recu[t]);
+        }
+        for(MPI_Request& r : e.envois){
+            int fini = 1;
+            if(r != MPI_REQUEST_NULL) MPI_Test(&r, &fini, MPI_STATUS_IGNORE);
+            if(!fini) attente.push_back(&r);
+        }
+    }
+    if(f.m.temps) f.m.compter(PHASE_DIFFUSION, f.K_bas, t0);
+
+    // Ne bloque pas si une réception vient d'aboutir : ses tâches passent
+    // d'abord, les messages attendus pouvant en dépendre chez les autres
+    if(attendre && !arrive && !fermerEtapesFlux(f)){
+        if(attente.empty()){
+            cerr << "fermetureFluxLocal : aucune tâche prête ni communication en cours (étape "
+                 << f.K_bas << ")" << endl;
+            MPI_Abort(d.g.grille, 1);
+        }
+        t0 = MPI_Wtime();
+        vector<MPI_Request> r(attente.size());
+        for(size_t x=0; x<attente.size(); x++) r[x] = *attente[x];
+        int idx;
+        MPI_Waitany((int)r.size(), r.data(), &idx, MPI_STATUS_IGNORE);
+        *attente[idx] = MPI_REQUEST_NULL;
+        if(f.m.temps) f.m.compter(PHASE_ATTENTE, f.K_bas, t0);
+    }
+    fermerEtapesFlux(f);
+}
+
+template<typename S>
+void fermetureFluxLocal(typename S::T* X_local, const Distribution& dist, int num_threads,
+                        int fenetre, TempsPhases* temps) {
+    typedef typename S::T T;
+    if(num_threads > 0)
+        omp_set_num_threads(num_threads);
+
+    Flux<S> f;
+    Moteur<S>& m = f.m;
+    m.d = &dist;
+    m.D_local = X_local;
+    m.N_local = nullptr;
+    m.temps = temps;
+    if(temps && temps->par_etape && temps->etapes.size() != (size_t)dist.nblocs*NB_PHASES)
+        temps->etapes.assign((size_t)dist.nblocs*NB_PHASES, 0.0);
+    m.w = S::mots(dist.nb);
+    m.bb = dist.nb*m.w;
+    MPI_Type_contiguous(m.bb, typeMPI<T>(), &m.type_bloc);
+    MPI_Type_commit(&m.type_bloc);
+    MPI_Type_create_resized(m.type_bloc, 0, (MPI_Aint)dist.colonnes*m.bb*sizeof(T),
+                            &m.type_colonne);
+    MPI_Type_commit(&m.type_colonne);
+
+    f.fenetre = max(1, min(fenetre, dist.nblocs));
+    f.K_bas = 0;
+    f.version.assign((size_t)dist.lignes*dist.colonnes, 0);
+    f.etapes.resize(f.fenetre);
+    for(EtapeFlux<T>& e : f.etapes){
+        e.pivot = new T[m.bb];
+        e.ligne = new T[(long)dist.colonnes*m.bb];
+        e.colonne = new T[(long)dist.lignes*m.bb];
+    }
+    for(int K=0; K<f.fenetre; K++)
+        ouvrirEtapeFlux(f, K);
+
+    while(f.K_bas < dist.nblocs){
+        bool fait = tachesPanneaux(f);
+        fait = tachesReste(f) || fait;
+        progresserFlux(f, !fait);
+    }
+
+    for(EtapeFlux<T>& e : f.etapes){
+        delete[] e.pivot;
+        delete[] e.ligne;
+        delete[] e.colonne;
+    }
+    MPI_Type_free(&m.type_colonne);
+    MPI_Type_free(&m.type_bloc);
+}
+
+/* Fermeture 2.5D : état d'une couche de la grille 3D */
+template<typename S>
+struct Couches {
+    typedef typename S::T T;
+    Distribution d;             // distribution de la couche (même nb que dist)
+    MPI_Comm fibre;             // même position dans chaque couche, rang = couche
+    int c, couche;
+    int w, bb;
+    T* X;                       // blocs locaux de la couche
+    vector<T> ligne, colonne;   // panneaux K reçus
+    MPI_Datatype type_bloc;
+    TempsPhases* temps;
+
+    T* bloc(int li, int lj) const {
+        return X + ((long)li * d.colonnes + lj) * bb;
+    }
+
+    /* Ajoute le temps écoulé depuis t0 à une phase */
+    void compter(PhaseFloyd phase, double t0) const {
+        static double TempsPhases::* const champs[NB_PHASES] = {
+            &TempsPhases::panneaux, &TempsPhases::diffusion, &TempsPhases::reste, &TempsPhases::attente};
+        if(temps) temps->*champs[phase] += MPI_Wtime() - t0;
+    }
+};
+
+/* ⊕ du semi-anneau comme réduction MPI */
+template<typename P> static MPI_Op reductionMPI(MinPlus<P>) { return MPI_MIN; }
+template<typename P> static MPI_Op reductionMPI(MaxMin<P>) { return MPI_MAX; }
+static MPI_Op reductionMPI(Accessibilite) { return MPI_BOR; }
+
+/* Échange de blocs entiers entre deux distributions (MPI_Alltoallv sur
+ * comm) : le bloc (I, J) de src part vers les rangs vers(I, J, x), x <
+ * copies (-1 : pas d'envoi), le bloc (I, J) de dst arrive de de(I, J)
+ * (-1 : bloc inchangé). Les blocs voyagent dans l'ordre (I, J) croissant
+ * des deux côtés. */
+template<typename T, typename Vers, typename De>
+static void echangerBlocs(const T* X_src, const Distribution& src, int copies, Vers vers,
+                          T* X_dst, const Distribution& dst, De de,
+                          int bb, MPI_Datatype type_bloc, MPI_Comm comm) {
+    int nprocs;
+    MPI_Comm_size(comm, &nprocs);
+    vector<int> nenv(nprocs, 0), nrec(nprocs, 0), denv(nprocs, 0), drec(nprocs, 0);
+    for(int li=0; li<src.lignes; li++)
+        for(int lj=0; lj<src.colonnes; lj++)
+            for(int x=0; x<copies; x++){
+                int r = vers(blocGlobalLigne(src, li), blocGlobalColonne(src, lj), x);
+                if(r >= 0) nenv[r]++;
+            }
+    for(int li=0; li<dst.lignes; li++)
+        for(int lj=0; lj<dst.colonnes; lj++){
+            int r = de(blocGlobalLigne(dst, li), blocGlobalColonne(dst, lj));
+            if(r >= 0) nrec[r]++;
+        }
+    for(int p=1; p<nprocs; p++){
+        denv[p] = denv[p-1] + nenv[p-1];
+        drec[p] = drec[p-1] + nrec[p-1];
+    }
+
+    vector<T> envoi((size_t)(denv[nprocs-1] + nenv[nprocs-1]) * bb);
+    vector<T> recu((size_t)(drec[nprocs-1] + nrec[nprocs-1]) * bb);
+    vector<int> pos = denv;
+    for(int li=0; li<src.lignes; li++)
+        for(int lj=0; lj<src.colonnes; lj++){
+            const T* B = X_src + ((long)li * src.colonnes + lj) * bb;
+            for(int x=0; x<copies; x++){
+                int r = vers(blocGlobalLigne(src, li), blocGlobalColonne(src, lj), x);
+                if(r >= 0) copy(B, B + bb, envoi.begin() + (long)pos[r]++ * bb);
+            }
+        }
+    MPI_Alltoallv(envoi.data(), nenv.data(), denv.data(), type_bloc,
+                  recu.data(), nrec.data(), drec.data(), type_bloc, comm);
+    pos = drec;
+    for(int li=0; li<dst.lignes; li++)
+        for(int lj=0; lj<dst.colonnes; lj++){
+            int r = de(blocGlobalLigne(dst, li), blocGlobalColonne(dst, lj));
+            if(r >= 0)
+                copy_n(recu.begin() + (long)pos[r]++ * bb, bb, X_dst + ((long)li * dst.colonnes + lj) * bb);
+        }
+}
+
+/* C ⊕= A ⊗ B sur les blocs [i0,i1) x [j0,j1), avec A les blocs [i0,i1) x
+ * [k0,k1) et B les blocs [k0,k1) x [j0,j1) (SUMMA). La couche traite les
+ * blocs K tels que K - k0 = couche mod c ; les panneaux sont toujours
+ * copiés avant diffusion, C pouvant recouvrir A ou B. Les résultats
+ * partiels des couches sont ensuite réduits par ⊕. */
+template<typename S>
+static void produitCouches(Couches<S>& x, int i0, int i1, int j0, int j1, int k0, int k1) {
+    typedef typename S::T T;
+    const Distribution& d = x.d;
+    int nb = d.nb;
+    // Lignes et colonnes de blocs locales des intervalles : contiguës
+    int li0 = d.lignes, li1 = 0, lj0 = d.colonnes, lj1 = 0;
+    for(int li=0; li<d.lignes; li++){
+        int I = blocGlobalLigne(d, li);
+        if(I >= i0 && I < i1){ li0 = min(li0, li); li1 = li+1; }
+    }
+    for(int lj=0; lj<d.colonnes; lj++){
+        int J = blocGlobalColonne(d, lj);
+        if(J >= j0 && J < j1){ lj0 = min(lj0, lj); lj1 = lj+1; }
+    }
+    int nl = max(0, li1 - li0), nc = max(0, lj1 - lj0);
+
+    for(int K = k0 + x.couche; K < k1; K += x.c){
+        int kr = K % d.g.pr, kc = K % d.g.pc;
+        double t0 = MPI_Wtime();
+        // Colonne de blocs K le long des lignes de la grille, ligne de blocs
+        // K le long des colonnes ; les communicateurs sans bloc de C n'y
+        // participent pas (nl ne dépend que de px, nc que de py)
+        if(nl > 0){
+            if(d.g.py == kc)
+                for(int a=0; a<nl; a++)
+                    copy_n(x.bloc(li0 + a, K / d.g.pc), x.bb, x.colonne.begin() + (long)a * x.bb);
+            MPI_Bcast(x.colonne.data(), nl, x.type_bloc, kc, d.g.ligne);
+        }
+        if(nc > 0){
+            if(d.g.px == kr)
+                copy_n(x.bloc(K / d.g.pr, lj0), (long)nc * x.bb, x.ligne.begin());
+            MPI_Bcast(x.ligne.data(), nc, x.type_bloc, kr, d.g.colonne);
+        }
+        x.compter(PHASE_DIFFUSION, t0);
+        if(nl == 0 || nc == 0) continue;
+
+        t0 = MPI_Wtime();
+        const T* A = x.colonne.data();
+        const T* B = x.ligne.data();
+        // Comme en phase 5, une bande de A ou un bloc de B vide n'apporte rien
+        struct Travail { int a, b, r0; };
+        vector<Travail> travaux;
+        vector<char> B_vide(nc, 0);
+        if(FLOYD_SAUT_TUILES)
+            for(int b=0; b<nc; b++)
+                B_vide[b] = S::vide(resumer(B + (long)b * x.bb, x.bb));
+        for(int a=0; a<nl; a++)
+            for(int r0=0; r0<nb; r0+=FLOYD_SOUS_TUILE){
+                const T* Ab = A + (long)a * x.bb + (long)r0 * x.w;
+                if(FLOYD_SAUT_TUILES && S::vide(resumer(Ab, (long)min(FLOYD_SOUS_TUILE, nb - r0) * x.w)))
+                    continue;
+                for(int b=0; b<nc; b++)
+                    if(!B_vide[b]) travaux.push_back({a, b, r0});
+            }
+        #pragma omp parallel for schedule(dynamic)
+        for(size_t t=0; t<travaux.size(); t++){
+            const Travail& v = travaux[t];
+            long l = (long)v.r0 * x.w;
+            majBande(S(), x.bloc(li0 + v.a, lj0 + v.b) + l, nullptr, A + (long)v.a * x.bb + l, nullptr,
+                     B + (long)v.b * x.bb, min(FLOYD_SOUS_TUILE, nb - v.r0), nb);
+        }
+        x.compter(PHASE_RESTE, t0);
+    }
+
+    // Réduction entre couches, ligne de blocs par ligne de blocs (contiguë)
+    if(x.c > 1 && nl > 0 && nc > 0){
+        double t0 = MPI_Wtime();
+        for(int li=li0; li<li1; li++)
+            MPI_Allreduce(MPI_IN_PLACE, x.bloc(li, lj0), nc * x.bb, typeMPI<T>(),
+                          reductionMPI(S()), x.fibre);
+        x.compter(PHASE_DIFFUSION, t0);
+    }
+}
+
+/* Fermeture de Kleene des blocs [a, b) x [a, b) */
+template<typename S>
+static void fermetureKleene(Couches<S>& x, int a, int b) {
+    const Distribution& d = x.d;
+    if(b - a == 1){
+        // Chaque couche ferme sa copie du bloc diagonal
+        if(d.g.px == a % d.g.pr && d.g.py == a % d.g.pc){
+            double t0 = MPI_Wtime();
+            fermerBloc(S(), x.bloc(a / d.g.pr, a / d.g.pc), nullptr, d.nb);
+            x.compter(PHASE_PANNEAUX, t0);
+        }
+        return;
+    }
+    int m = (a + b) / 2;
+    fermetureKleene(x, a, m);
+    produitCouches(x, a, m, m, b, a, m);   // A12 = A11 ⊗ A12
+    produitCouches(x, m, b, a, m, a, m);   // A21 = A21 ⊗ A11
+    produitCouches(x, m, b, m, b, a, m);   // A22 ⊕= A21 ⊗ A12
+    fermetureKleene(x, m, b);
+    produitCouches(x, m, b, a, m, m, b);   // A21 = A22 ⊗ A21
+    produitCouches(x, a, m, m, b, m, b);   // A12 = A12 ⊗ A22
+    produitCouches(x, a, m, a, m, m, b);   // A11 ⊕= A12 ⊗ A21
+}
+
+template<typename S>
+void fermetureCouchesLocal(typename S::T* X_local, const Distribution& dist, int couches,
+                           int num_threads, TempsPhases* temps) {
+    typedef typename S::T T;
+    if(num_threads > 0)
+        omp_set_num_threads(num_threads);
+
+    int rang, nprocs;
+    MPI_Comm_rank(dist.g.grille, &rang);
+    MPI_Comm_size(dist.g.grille, &nprocs);
+    Couches<S> x;
+    x.c = couches;
+    int taille = nprocs / couches;
+    x.couche = rang / taille;
+    x.temps = temps;
+    MPI_Comm comm_couche;
+    MPI_Comm_split(dist.g.grille, x.couche, rang, &comm_couche);
+    x.d = creerDistribution(dist.n, dist.nb, 0, 0, comm_couche);
+    MPI_Comm_free(&comm_couche);
+    MPI_Comm_split(dist.g.grille, rang % taille, x.couche, &x.fibre);
+
+    const Distribution& d = x.d;
+    x.w = S::mots(d.nb);
+    x.bb = d.nb * x.w;
+    x.X = new T[(long)d.lignes * d.colonnes * x.bb];
+    x.ligne.resize((size_t)d.colonnes * x.bb);
+    x.colonne.resize((size_t)d.lignes * x.bb);
+    MPI_Type_contiguous(x.bb, typeMPI<T>(), &x.type_bloc);
+    MPI_Type_commit(&x.type_bloc);
+
+    // Propriétaires d'un bloc : dans dist, et dans la couche l (rangs consécutifs)
+    auto monde = [&dist](int I, int J) { return (I % dist.g.pr) * dist.g.pc + J % dist.g.pc; };
+    auto dans = [&d, taille](int l, int I, int J) {
+        return l * taille + (I % d.g.pr) * d.g.pc + J % d.g.pc;
+    };
+
+    // Une copie de chaque bloc dans chaque couche
+    double t0 = MPI_Wtime();
+    echangerBlocs(X_local, dist, couches, [&](int I, int J, int l) { return dans(l, I, J); },
+                  x.X, d, monde, x.bb, x.type_bloc, dist.g.grille);
+    x.compter(PHASE_DIFFUSION, t0);
+
+    fermetureKleene(x, 0, d.nblocs);
+
+    // Retour : le bloc (I, J) revient de la couche (I + J) mod c
+    t0 = MPI_Wtime();
+    echangerBlocs(x.X, d, 1,
+                  [&](int I, int J, int) { return (I + J) % couches == x.couche ? monde(I, J) : -1; },
+                  X_local, dist, [&](int I, int J) { return dans((I + J) % couches, I, J); },
+                  x.bb, x.type_bloc, dist.g.grille);
+    x.compter(PHASE_DIFFUSION, t0);
+
+    MPI_Type_free(&x.type_bloc);
+    delete[] x.X;
+    MPI_Comm_free(&x.fibre);
+    libererDistribution(x.d);
+}
+
+/* Fermeture symétrique : état sur un processus. colonne[li] reçoit le bloc
+ * (I, K) de chaque ligne locale li et ligne[lj] le bloc (K, J) de chaque
+ * colonne locale lj, recopiés ou transposés depuis le triangle supérieur */
+template<typename S>
+struct Symetrique {
+    typedef typename S::T T;
+    const Distribution* d;
+    const Triangle* t;
+    T* X;
+    int bb;
+    vector<T> pivot, ligne, colonne;
+    vector<T> envoi, recu;      // blocs à transposer échangés par MPI_Allgatherv
+    MPI_Datatype type_bloc;
+    TempsPhases* temps;
+
+    T* bloc(int li, int lj) const {
+        return blocTriangle(X, *d, *t, li, lj);
+    }
+
+    /* Ajoute le temps écoulé depuis t0 à une phase de l'étape K */
+    void compter(PhaseFloyd phase, int K, double t0) const {
+        static double TempsPhases::* const champs[NB_PHASES] = {
+            &TempsPhases::panneaux, &TempsPhases::diffusion, &TempsPhases::reste, &TempsPhases::attente};
+        if(!temps) return;
+        double dt = MPI_Wtime() - t0;
+        temps->*champs[phase] += dt;
+        if(temps->par_etape)
+            temps->etapes[(long)K*NB_PHASES + phase] += dt;
+    }
+};
+
+/* B = Aᵀ pour des blocs nb x nb, par carreaux de 16 x 16 */
+template<typename T>
+static void transposerBloc(const T* A, T* B, int nb) {
+    const int c = 16;
+    for(int i0=0; i0<nb; i0+=c)
+        for(int j0=0; j0<nb; j0+=c)
+            for(int i=i0; i<min(nb, i0+c); i++)
+                for(int j=j0; j<min(nb, j0+c); j++)
+                    B[(long)j*nb + i] = A[(long)i*nb + j];
+}
+
+/* Échange de blocs le long d'une ligne (ou d'une colonne) de la grille :
+ * pour X dans [X0, X1) avec place(X) >= 0, le processus de rang
+ * proprio(X) apporte le bloc source(X), que tous reçoivent transposé en
+ * dst[place(X)] (MPI_Allgatherv). Les listes se déduisent de K : rien
+ * d'autre ne circule. */
+template<typename S, typename Proprio, typename Place, typename Source>
+static void echangerTransposees(Symetrique<S>& s, int X0, int X1, Proprio proprio, Place place,
+                                Source source, typename S::T* dst, MPI_Comm comm) {
+    int rang, taille;
+    MPI_Comm_rank(comm, &rang);
+    MPI_Comm_size(comm, &taille);
+    vector<int> compte(taille, 0), depl(taille, 0);
+    int total = 0;
+    s.envoi.clear();
+    for(int X=X0; X<X1; X++){
+        if(place(X) < 0) continue;
+        int q = proprio(X);
+        if(q == rang){
+            const typename S::T* B = source(X);
+            s.envoi.insert(s.envoi.end(), B, B + s.bb);
+        }
+        compte[q]++;
+        total++;
+    }
+    if(total == 0) return;
+    for(int q=1; q<taille; q++) depl[q] = depl[q-1] + compte[q-1];
+    s.recu.resize((size_t)(depl[taille-1] + compte[taille-1]) * s.bb);
+    MPI_Allgatherv(s.envoi.data(), compte[rang], s.type_bloc,
+                   s.recu.data(), compte.data(), depl.data(), s.type_bloc, comm);
+    vector<int> pos = depl;
+    for(int X=X0; X<X1; X++)
+        if(place(X) >= 0)
+            transposerBloc(s.recu.data() + (long)pos[proprio(X)]++ * s.bb,
+                           dst + (long)place(X) * s.bb, s.d->nb);
+}
+
+/* Étape K de la fermeture symétrique */
+template<typename S>
+static void etapeSymetrique(Symetrique<S>& s, int K) {
+    typedef typename S::T T;
+    const Distribution& d = *s.d;
+    int nb = d.nb, bb = s.bb;
+    int kr = K % d.g.pr, kc = K % d.g.pc;
+    int lr = K / d.g.pr, lc = K / d.g.pc;
+    bool sur_ligne = (d.g.px == kr), sur_colonne = (d.g.py == kc);
+    // Colonnes locales J > K : [lj0, colonnes) ; lignes locales I < K : [0, li1)
+    int lj0 = 0, li1 = 0;
+    while(lj0 < d.colonnes && blocGlobalColonne(d, lj0) <= K) lj0++;
+    while(li1 < d.lignes && blocGlobalLigne(d, li1) < K) li1++;
+    double t0 = MPI_Wtime();
+
+    // ======== PHASES 1 à 3 : pivot, blocs (K, J > K) et (I < K, K) ========
+    T* piv = s.pivot.data();
+    if(sur_ligne && sur_colonne){
+        piv = s.bloc(lr, lc);
+        fermerBloc(S(), piv, nullptr, nb);
+    }
+    s.compter(PHASE_PANNEAUX, K, t0);
+    t0 = MPI_Wtime();
+    if(sur_ligne)
+        MPI_Bcast(piv, bb, typeMPI<T>(), kc, d.g.ligne);
+    if(sur_colonne)
+        MPI_Bcast(piv, bb, typeMPI<T>(), kr, d.g.colonne);
+    s.compter(PHASE_DIFFUSION, K, t0);
+    t0 = MPI_Wtime();
+    // Un bloc vide le reste : P ⊗ neutre = neutre
+    if(sur_ligne)
+        for(int lj=lj0; lj<d.colonnes; lj++){
+            T* C = s.bloc(lr, lj);
+            if(!FLOYD_SAUT_TUILES || !S::vide(resumer(C, bb)))
+                majLignePivot(S(), C, nullptr, piv, nullptr, nb);
+            copy_n(C, bb, s.ligne.begin() + (long)lj * bb);
+        }
+    if(sur_colonne)
+        for(int li=0; li<li1; li++){
+            T* C = s.bloc(li, lc);
+            if(!FLOYD_SAUT_TUILES || !S::vide(resumer(C, bb)))
+                majColonnePivot(S(), C, nullptr, piv, nb);
+            copy_n(C, bb, s.colonne.begin() + (long)li * bb);
+        }
+    s.compter(PHASE_PANNEAUX, K, t0);
+
+    // ======== PHASE 4 : Diffusion de la ligne de blocs K ========
+    t0 = MPI_Wtime();
+    if(s.temps && s.temps->synchroniser){
+        MPI_Barrier(d.g.grille);
+        s.compter(PHASE_ATTENTE, K, t0);
+        t0 = MPI_Wtime();
+    }
+    // Blocs (K, J > K) le long des colonnes de la grille, (I < K, K) le long des lignes
+    if(lj0 < d.colonnes)
+        MPI_Bcast(s.ligne.data() + (long)lj0 * bb, d.colonnes - lj0, s.type_bloc, kr, d.g.colonne);
+    if(li1 > 0)
+        MPI_Bcast(s.colonne.data(), li1, s.type_bloc, kc, d.g.ligne);
+    // C[I][K], I > K, est la transposée de C[K][I] reçu par la colonne de
+    // processus I % pc ; le processus (I % pr, I % pc) le transmet à sa
+    // ligne. De même C[K][J], J < K, vient de C[J][K] par (J % pr, J % pc).
+    int px = d.g.px, py = d.g.py, pr = d.g.pr, pc = d.g.pc;
+    T* ligne = s.ligne.data();
+    T* colonne = s.colonne.data();
+    echangerTransposees(s, K + 1, d.nblocs, [pc](int I) { return I % pc; },
+                        [px, pr](int I) { return I % pr == px ? I / pr : -1; },
+                        [=](int I) { return ligne + (long)(I / pc) * bb; }, colonne, d.g.ligne);
+    echangerTransposees(s, 0, K, [pr](int J) { return J % pr; },
+                        [py, pc](int J) { return J % pc == py ? J / pc : -1; },
+                        [=](int J) { return colonne + (long)(J / pr) * bb; }, ligne, d.g.colonne);
+    s.compter(PHASE_DIFFUSION, K, t0);
+
+    // ======== PHASE 5 : blocs (I <= J) du triangle hors ligne et colonne K ========
+    t0 = MPI_Wtime();
+    struct Travail { T* C; const T* A; const T* B; int i0; };
+    vector<Travail> travaux;
+    vector<char> B_vide(d.colonnes, 0);
+    for(int lj=0; lj<d.colonnes && FLOYD_SAUT_TUILES; lj++)
+        if(blocGlobalColonne(d, lj) != K)
+            B_vide[lj] = S::vide(resumer(s.ligne.data() + (long)lj * bb, bb));
+    for(int li=0; li<d.lignes; li++){
+        if(blocGlobalLigne(d, li) == K) continue;
+        const T* A = s.colonne.data() + (long)li * bb;
+        for(int i0=0; i0<nb; i0+=FLOYD_SOUS_TUILE){
+            // Comme en 2D, une bande de A ou un bloc de B vide n'apporte rien
+            if(FLOYD_SAUT_TUILES && S::vide(resumer(A + (long)i0 * nb, (long)min(FLOYD_SOUS_TUILE, nb - i0) * nb)))
+                continue;
+            for(int lj=s.t->premiere[li]; lj<d.colonnes; lj++)
+                if(blocGlobalColonne(d, lj) != K && !B_vide[lj])
+                    travaux.push_back({s.bloc(li, lj), A, s.ligne.data() + (long)lj * bb, i0});
+        }
+    }
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t w=0; w<travaux.size(); w++){
+        const Travail& x = travaux[w];
+        long l = (long)x.i0 * nb;
+        majBande(S(), x.C + l, nullptr, x.A + l, nullptr, x.B, min(FLOYD_SOUS_TUILE, nb - x.i0), nb);
+    }
+    s.compter(PHASE_RESTE, K, t0);
+}
+
+template<typename S>
+void fermetureSymetriqueLocal(typename S::T* X, const Distribution& dist, const Triangle& tri,
+                              int num_threads, TempsPhases* temps) {
+    typedef typename S::T T;
+    if(num_threads > 0)
+        omp_set_num_threads(num_threads);
+
+    Symetrique<S> s;
+    s.d = &dist;
+    s.t = &tri;
+    s.X = X;
+    s.bb = dist.nb * dist.nb;
+    s.temps = temps;
+    if(temps && temps->par_etape && temps->etapes.size() != (size_t)dist.nblocs*NB_PHASES)
+        temps->etapes.assign((size_t)dist.nblocs*NB_PHASES, 0.0);
+    s.pivot.resize(s.bb);
+    s.ligne.resize((size_t)dist.colonnes * s.bb);
+    s.colonne.resize((size_t)dist.lignes * s.bb);
+    MPI_Type_contiguous(s.bb, typeMPI<T>(), &s.type_bloc);
+    MPI_Type_commit(&s.type_bloc);
+
+    for(int K=0; K<dist.nblocs; K++)
+        etapeSymetrique(s, K);
+
+    MPI_Type_free(&s.type_bloc);
+}
+
+/* Blocs initiaux écrits un à un dans le magasin, avec la convention de
+ * construireLocale : infini, 0 sur la diagonale, puis les entrées locales
+ * des arêtes dans l'ordre du fichier (rangées d'abord par bloc) */
+template<typename T>
+static void construireHorsMemoire(StockTuiles& s, const Distribution& dist,
+                                  const vector<int>& aretes) {
+    int nb = dist.nb;
+    long nbl = (long)dist.lignes * dist.colonnes;
+    const T inf = Poids<T>::infini();
+    vector<long> debut(nbl + 1, 0);
+    vector<pair<int, T> > entrees;
+    for (int passe = 0; passe < 2; passe++) {
+        if (passe == 1) {
+            for (long b = 0; b < nbl; b++) debut[b+1] += debut[b];
+            entrees.resize(debut[nbl]);
+        }
+        vector<long> pos(debut.begin(), debut.end() - 1);
+        for (size_t e = 0; e < aretes.size(); e += 3) {
+            int u = aretes[e], v = aretes[e+1], w = aretes[e+2];
+            if (u == v) continue;
+            for (int sens = 0; sens < 2; sens++) {
+                int i = sens ? v : u, j = sens ? u : v;
+                int I = i / nb, J = j / nb;
+                if (I % dist.g.pr != dist.g.px || J % dist.g.pc != dist.g.py) continue;
+                long b = (long)(I / dist.g.pr) * dist.colonnes + J / dist.g.pc;
+                if (passe == 0) debut[b+1]++;
+                else entrees[pos[b]++] = make_pair((i % nb)*nb + j % nb, (w == 0) ? inf : (T)w);
+            }
+        }
+    }
+    for (int li = 0; li < dist.lignes; li++)
+        for (int lj = 0; lj < dist.colonnes; lj++) {
+            long b = (long)li * dist.colonnes + lj;
+            int i0 = blocGlobalLigne(dist, li)*nb, j0 = blocGlobalColonne(dist, lj)*nb;
+            T* B = (T*)tuile(s, b, TUILE_NOUVELLE);
+            for (int i = 0; i < nb; i++)
+                for (int j = 0; j < nb; j++)
+                    B[i*nb + j] = (i0+i == j0+j) ? 0 : inf;
+            for (long x = debut[b]; x < debut[b+1]; x++)
+                B[entrees[x].first] = entrees[x].second;
+        }
+}
+
+template<typename T>
+int floydHorsMemoire(const int* aretes, long nb_aretes, const Distribution& dist, int root,
+                     int num_threads, HorsMemoire* hm) {
+    if (num_threads > 0)
+        omp_set_num_threads(num_threads);
+    int nb = dist.nb;
+    long bb = (long)nb * nb;
+    long nbl = (long)dist.lignes * dist.colonnes;
+    int rang;
+    MPI_Comm_rank(dist.g.grille, &rang);
+
+    // Régions des processus à la suite ; le root crée le fichier à sa taille
+    // finale avant que les autres ne l'ouvrent
+    long long octets = nbl * bb * (long long)sizeof(T), avant = 0, total;
+    MPI_Exscan(&octets, &avant, 1, MPI_LONG_LONG, MPI_SUM, dist.g.grille);
+    MPI_Allreduce(&octets, &total, 1, MPI_LONG_LONG, MPI_SUM, dist.g.grille);
+    if (rang == 0) avant = 0;
+    int ok = 1;
+    if (rang == root) {
+        int fd = open(hm->fichier, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        ok = (fd >= 0 && ftruncate(fd, total) == 0);
+        if (fd >= 0) close(fd);
+    }
+    MPI_Bcast(&ok, 1, MPI_INT, root, dist.g.grille);
+    if (!ok) return -1;
+
+    // Le cache reçoit ce qui reste une fois le pivot et les panneaux K alloués
+    long long panneaux = (1LL + dist.lignes + dist.colonnes) * bb * (long long)sizeof(T);
+    int capacite = (int)max(2LL, (hm->memoire - panneaux) / (bb * (long long)sizeof(T)));
+    int ouvert = ouvrirStock(&hm->stock, hm->fichier, avant, nbl, bb * sizeof(T), capacite) == 0;
+    MPI_Allreduce(&ouvert, &ok, 1, MPI_INT, MPI_MIN, dist.g.grille);
+    if (!ok) {
+        if (ouvert) fermerStock(hm->stock);
+        return -1;
+    }
+    StockTuiles& s = hm->stock;
+
+    double t0 = MPI_Wtime();
+    construireHorsMemoire<T>(s, dist, aretesLocales(aretes, nb_aretes, dist, root));
+    hm->temps_construction = MPI_Wtime() - t0;
+
+    MinPlus<T> S;
+    T* pivot = new T[bb];
+    T* ligne_k = new T[dist.colonnes * bb];
+    T* colonne_k = new T[dist.lignes * bb];
+    MPI_Datatype type_bloc;
+    MPI_Type_contiguous((int)bb, typeMPI<T>(), &type_bloc);
+    MPI_Type_commit(&type_bloc);
+    vector<long> ordre;
+    vector<T*> lot;
+    int bandes = (nb + FLOYD_SOUS_TUILE - 1) / FLOYD_SOUS_TUILE;
+
+    for (int K = 0; K < dist.nblocs; K++) {
+        int kr = K % dist.g.pr, kc = K % dist.g.pc;
+        int lr = K / dist.g.pr, lc = K / dist.g.pc;
+        bool sur_ligne = (dist.g.px == kr);
+        bool sur_colonne = (dist.g.py == kc);
+
+        // ======== PHASE 1 : bloc pivot [K,K] ========
+        if (sur_ligne && sur_colonne) {
+            T* P = (T*)tuile(s, (long)lr * dist.colonnes + lc, TUILE_ECRITURE);
+            fermerBloc(S, P, nullptr, nb);
+            copy(P, P + bb, pivot);
+        }
+        if (sur_ligne)
+            MPI_Bcast(pivot, (int)bb, typeMPI<T>(), kc, dist.g.ligne);
+        if (sur_colonne)
+            MPI_Bcast(pivot, (int)bb, typeMPI<T>(), kr, dist.g.colonne);
+
+        // ======== PHASES 2 et 3 : ligne et colonne K, copiées dans les panneaux ========
+        if (sur_ligne)
+            for (int lj = 0; lj < dist.colonnes; lj++) {
+                bool piv = (blocGlobalColonne(dist, lj) == K);
+                T* C = (T*)tuile(s, (long)lr * dist.colonnes + lj, piv ? TUILE_LECTURE : TUILE_ECRITURE);
+                if (!piv) majLignePivot(S, C, nullptr, pivot, nullptr, nb);
+                copy(C, C + bb, ligne_k + lj * bb);
+            }
+        if (sur_colonne)
+            for (int li = 0; li < dist.lignes; li++) {
+                bool piv = (blocGlobalLigne(dist, li) == K);
+                T* C = (T*)tuile(s, (long)li * dist.colonnes + lc, piv ? TUILE_LECTURE : TUILE_ECRITURE);
+                if (!piv) majColonnePivot(S, C, nullptr, pivot, nb);
+                copy(C, C + bb, colonne_k + li * bb);
+            }
+
+        // ======== PHASE 4 : diffusion des panneaux ========
+        MPI_Bcast(ligne_k, dist.colonnes, type_bloc, kr, dist.g.colonne);
+        MPI_Bcast(colonne_k, dist.lignes, type_bloc, kc, dist.g.ligne);
+
+        // ======== PHASE 5 : autres blocs, par lots de la taille du cache ========
+        // Ligne et colonne K+1 en dernier : elles restent en cache pour l'étape K+1
+        ordre.clear();
+        for (int passe = 0; passe < 2; passe++)
+            for (int li = 0; li < dist.lignes; li++)
+                for (int lj = 0; lj < dist.colonnes; lj++) {
+                    int I = blocGlobalLigne(dist, li), J = blocGlobalColonne(dist, lj);
+                    if (I == K || J == K) continue;
+                    if ((I == K+1 || J == K+1) == (passe == 1))
+                        ordre.push_back((long)li * dist.colonnes + lj);
+                }
+        size_t taille_lot = s.capacite, nt = ordre.size();
+        for (size_t d0 = 0; d0 < nt; d0 += taille_lot) {
+            size_t d1 = min(nt, d0 + taille_lot);
+            // Lecture anticipée du lot suivant (en fin d'étape : début de l'ordre,
+            // proche de celui de l'étape K+1)
+            for (size_t x = d1; x < d1 + taille_lot && x - d1 < nt; x++)
+                anticiperTuile(s, ordre[x % nt]);
+            lot.clear();
+            for (size_t x = d0; x < d1; x++)
+                lot.push_back((T*)tuile(s, ordre[x], TUILE_ECRITURE));
+
+            int nw = (int)lot.size() * bandes;
+            #pragma omp parallel for schedule(dynamic)
+            for (int w = 0; w < nw; w++) {
+                long b = ordre[d0 + w / bandes];
+                long li = b / dist.colonnes, lj = b % dist.colonnes;
+                int i0 = (w % bandes) * FLOYD_SOUS_TUILE;
+                int h = min(FLOYD_SOUS_TUILE, nb - i0);
+                majBande(S, lot[w / bandes] + (long)i0 * nb, nullptr,
+                         colonne_k + li * bb + (long)i0 * nb, nullptr, ligne_k + lj * bb, h, nb);
+            }
+        }
+    }
+    viderStock(s);
+
+    MPI_Type_free(&type_bloc);
+    delete[] pivot;
+    delete[] ligne_k;
+    delete[] colonne_k;
+    return 0;
+}
+
+/* Fichier résultat : en-tête de 32 octets, puis la matrice n x n par lignes */
+struct EnteteResultat {
+    char magie[8];          // "FLOYDRS1"
+    int32_t taille_elem;    // sizeof(T)
+    int32_t flottant;       // T flottant
+    int64_t n;
+    int64_t reserve;
+};
+static const char MAGIE_RESULTAT[8] = {'F','L','O','Y','D','R','S','1'};
+
+/* Ouvre (et tronque) le fichier résultat, le root écrit l'en-tête ;
+ * collectif. *fh vaut MPI_FILE_NULL si l'ouverture échoue, le résultat est
+ * faux en cas d'échec sur ce processus */
+template<typename T>
+static bool ouvrirResultat(const char* f, long n, MPI_Comm comm, MPI_File* fh) {
+    int rang;
+    MPI_Comm_rank(comm, &rang);
+    if (MPI_File_open(comm, f, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, fh) != MPI_SUCCESS) {
+        *fh = MPI_FILE_NULL;
+        return false;
+    }
+    bool ok = MPI_File_set_size(*fh, sizeof(EnteteResultat) + (MPI_Offset)n * n * sizeof(T)) == MPI_SUCCESS;
+    if (rang == 0) {
+        EnteteResultat e;
+        memset(&e, 0, sizeof(e));
+        memcpy(e.magie, MAGIE_RESULTAT, 8);
+        e.taille_elem = sizeof(T);
+        e.flottant = !numeric_limits<T>::is_integer;
+        e.n = n;
+        ok &= MPI_File_write_at(*fh, 0, &e, sizeof(e), MPI_BYTE, MPI_STATUS_IGNORE) == MPI_SUCCESS;
+    }
+    return ok;
+}
+
+/* Ferme le fichier résultat ; succès seulement si tous les processus ont réussi */
+static int fermerResultat(MPI_File* fh, bool ok, MPI_Comm comm) {
+    int tous = (*fh != MPI_FILE_NULL) && (MPI_File_close(fh) == MPI_SUCCESS) && ok;
+    MPI_Allreduce(MPI_IN_PLACE, &tous, 1, MPI_INT, MPI_MIN, comm);
+    return tous ? 0 : -1;
+}
+
+template<typename T>
+int ecrireResultat(const char* f, const T* D_local, const Distribution& dist) {
+    int n = dist.n, nb = dist.nb;
+    int rang;
+    MPI_Comm_rank(dist.g.grille, &rang);
+    MPI_File fh;
+    bool ok = ouvrirResultat<T>(f, n, dist.g.grille, &fh);
+    if (fh == MPI_FILE_NULL) return fermerResultat(&fh, false, dist.g.grille);
+
+    // Vue : entrées (i, j) du processus dans la matrice n x n, parcourues
+    // ligne par ligne de sa matrice locale (ordre de MPI_Type_create_darray)
+    MPI_Datatype vue, memoire;
+    int tailles[2] = {n, n};
+    int distribs[2] = {MPI_DISTRIBUTE_CYCLIC, MPI_DISTRIBUTE_CYCLIC};
+    int args[2] = {nb, nb};
+    int grille[2] = {dist.g.pr, dist.g.pc};
+    MPI_Type_create_darray(dist.g.pr * dist.g.pc, rang, 2, tailles, distribs, args, grille,
+                           MPI_ORDER_C, typeMPI<T>(), &vue);
+    MPI_Type_commit(&vue);
+
+    // Mêmes entrées dans D_local, dans le même ordre : une ligne de chaque
+    // bloc de la ligne de blocs li, puis la ligne suivante
+    vector<int> longueurs;
+    vector<MPI_Aint> depl;
+    for (int li = 0; li < dist.lignes; li++) {
+        int i0 = blocGlobalLigne(dist, li) * nb;
+        for (int i = 0; i < nb && i0 + i < n; i++)
+            for (int lj = 0; lj < dist.colonnes; lj++) {
+                int j0 = blocGlobalColonne(dist, lj) * nb;
+                longueurs.push_back(min(nb, n - j0));
+                depl.push_back((MPI_Aint)(((long)li * dist.colonnes + lj) * nb * nb + (long)i * nb) * sizeof(T));
+            }
+    }
+    MPI_Type_create_hindexed((int)longueurs.size(), longueurs.data(), depl.data(), typeMPI<T>(), &memoire);
+    MPI_Type_commit(&memoire);
+
+    ok &= MPI_File_set_view(fh, sizeof(EnteteResultat), typeMPI<T>(), vue, "native", MPI_INFO_NULL) == MPI_SUCCESS;
+    ok &= MPI_File_write_all(fh, D_local, 1, memoire, MPI_STATUS_IGNORE) == MPI_SUCCESS;
+    MPI_Type_free(&memoire);
+    MPI_Type_free(&vue);
+    return fermerResultat(&fh, ok, dist.g.grille);
+}
+
+template<typename T>
+int ecrireResultatHorsMemoire(const char* f, HorsMemoire* hm, const Distribution& dist) {
+    int n = dist.n, nb = dist.nb;
+    MPI_File fh;
+    bool ok = ouvrirResultat<T>(f, n, dist.g.grille, &fh);
+    if (fh == MPI_FILE_NULL) return fermerResultat(&fh, false, dist.g.grille);
+
+    // Un bloc en mémoire à la fois, écrit ligne par ligne à sa place
+    // (écritures indépendantes : le nombre de blocs varie selon le processus)
+    for (int li = 0; li < dist.lignes && ok; li++)
+        for (int lj = 0; lj < dist.colonnes && ok; lj++) {
+            int i0 = blocGlobalLigne(dist, li) * nb, j0 = blocGlobalColonne(dist, lj) * nb;
+            const T* B = (const T*)tuile(hm->stock, (long)li * dist.colonnes + lj, TUILE_LECTURE);
+            for (int i = 0; i < nb && i0 + i < n && ok; i++) {
+                MPI_Offset pos = sizeof(EnteteResultat) + ((MPI_Offset)(i0 + i) * n + j0) * sizeof(T);
+                ok = MPI_File_write_at(fh, pos, B + (long)i * nb, min(nb, n - j0), typeMPI<T>(),
+                                       MPI_STATUS_IGNORE) == MPI_SUCCESS;
+            }
+        }
+    return fermerResultat(&fh, ok, dist.g.grille);
+}
+
+int ecrireResultatLignes(const char* f, const int* lignes, int premiere, int nb_lignes,
+                         int n, MPI_Comm comm) {
+    MPI_File fh;
+    bool ok = ouvrirResultat<int>(f, n, comm, &fh);
+    if (fh == MPI_FILE_NULL) return fermerResultat(&fh, false, comm);
+    MPI_Datatype ligne;
+    MPI_Type_contiguous(n, MPI_INT, &ligne);
+    MPI_Type_commit(&ligne);
+    MPI_Offset pos = sizeof(EnteteResultat) + (MPI_Offset)premiere * n * sizeof(int);
+    ok &= MPI_File_write_at_all(fh, pos, lignes, nb_lignes, ligne, MPI_STATUS_IGNORE) == MPI_SUCCESS;
+    MPI_Type_free(&ligne);
+    return fermerResultat(&fh, ok, comm);
+}
+
+void reduireTempsPhases(const TempsPhases& t, StatistiquesPhase* stats, MPI_Comm comm, int root) {
+    const int nv = NB_PHASES + 1;
+    int rang, nprocs;
+    MPI_Comm_rank(comm, &rang);
+    MPI_Comm_size(comm, &nprocs);
+    double v[nv] = {t.panneaux, t.diffusion, t.reste, t.attente, 0};
+    for (int p = 0; p < NB_PHASES; p++) v[NB_PHASES] += v[p];
+    double v_min[nv], v_max[nv], v_somme[nv];
+    MPI_Reduce(v, v_min, nv, MPI_DOUBLE, MPI_MIN, root, comm);
+    MPI_Reduce(v, v_max, nv, MPI_DOUBLE, MPI_MAX, root, comm);
+    MPI_Reduce(v, v_somme, nv, MPI_DOUBLE, MPI_SUM, root, comm);
+    if (rang != root) return;
+    for (int p = 0; p < nv; p++) {
+        double moyenne = v_somme[p] / nprocs;
+        stats[p] = {v_min[p], moyenne, v_max[p], moyenne > 0 ? v_max[p] / moyenne - 1 : 0};
+    }
+}
+
+int ecrireTempsRangs(const char* f, const TempsPhases& t, const GrilleProcessus& grille, int root) {
+    int rang, nprocs;
+    MPI_Comm_rank(grille.grille, &rang);
+    MPI_Comm_size(grille.grille, &nprocs);
+    // Totaux puis durées par étape, NB_PHASES valeurs chacun
+    vector<double> v = {t.panneaux, t.diffusion, t.reste, t.attente};
+    v.insert(v.end(), t.etapes.begin(), t.etapes.end());
+    int longueur = (int)v.size();
+    vector<int> longueurs(nprocs), depl(nprocs, 0);
+    MPI_Gather(&longueur, 1, MPI_INT, longueurs.data(), 1, MPI_INT, root, grille.grille);
+    for (int p = 1; p < nprocs; p++) depl[p] = depl[p-1] + longueurs[p-1];
+    vector<double> tout(rang == root ? depl[nprocs-1] + longueurs[nprocs-1] : 0);
+    MPI_Gatherv(v.data(), longueur, MPI_DOUBLE, tout.data(), longueurs.data(), depl.data(),
+                MPI_DOUBLE, root, grille.grille);
+
+    int ok = 1;
+    if (rang == root) {
+        ofstream out(f);
+        ok = out.good();
+        out << "rang,px,py,etape,panneaux,diffusion,reste,attente" << endl;
+        for (int p = 0; p < nprocs && ok; p++) {
+            int coords[2];
+            MPI_Cart_coords(grille.grille, p, 2, coords);
+            for (int e = 0; (e+1)*NB_PHASES <= longueurs[p]; e++) {
+                const double* x = tout.data() + depl[p] + e*NB_PHASES;
+                out << p << "," << coords[0] << "," << coords[1] << ","
+                    << (e == 0 ? string("total") : to_string(e-1));
+                for (int q = 0; q < NB_PHASES; q++) out << "," << x[q];
+                out << "\n";
+            }
+        }
+        ok = ok && out.good();
+    }
+    MPI_Bcast(&ok, 1, MPI_INT, root, grille.grille);
+    return ok ? 0 : -1;
+}
+
+template<typename T>
+void initialiserSuivants(const T* D_local, int* N_local, const Distribution& dist) {
+    int nb = dist.nb;
+    for (int li = 0; li < dist.lignes; li++)
+        for (int lj = 0; lj < dist.colonnes; lj++) {
+            int i0 = blocGlobalLigne(dist, li)*nb, j0 = blocGlobalColonne(dist, lj)*nb;
+            const T* B = blocLocal(const_cast<T*>(D_local), dist, li, lj);
+            int* S = blocLocal(N_local, dist, li, lj);
+            for (int i = 0; i < nb; i++)
+                for (int j = 0; j < nb; j++) {
+                    bool arete = (i0+i != j0+j) && j0+j < dist.n && B[i*nb + j] < Poids<T>::infini();
+                    S[i*nb + j] = arete ? j0+j : -1;
+                }
+        }
+}
+
+/* Successeur de (i, j) lu par son propriétaire puis diffusé à tous */
+static int suivantDistribue(const int* N_local, const Distribution& d, int i, int j) {
+    int I = i / d.nb, J = j / d.nb;
+    int coords[2] = {I % d.g.pr, J % d.g.pc};
+    int proprio;
+    MPI_Cart_rank(d.g.grille, coords, &proprio);
+    int s = -1;
+    if (d.g.px == coords[0] && d.g.py == coords[1])
+        s = blocLocal(const_cast<int*>(N_local), d, I / d.g.pr, J / d.g.pc)[(i % d.nb)*d.nb + j % d.nb];
+    MPI_Bcast(&s, 1, MPI_INT, proprio, d.g.grille);
+    return s;
+}
+
+vector<int> cheminDistribue(const int* N_local, const Distribution& dist, int i, int j) {
+    vector<int> chemin = {i};
+    while (i != j) {
+        int s = suivantDistribue(N_local, dist, i, j);
+        // Pas de chemin, ou successeurs incohérents (plus de n sauts)
+        if (s < 0 || (int)chemin.size() > dist.n) return {};
+        chemin.push_back(s);
+        i = s;
+    }
+    return chemin;
+}
+
+/* Fragments locaux de la colonne u (lignes locales) et de la ligne v
+ * (colonnes locales) de D, diffusés depuis leurs propriétaires le long des
+ * lignes et des colonnes de la grille ; idem pour la colonne u des
+ * successeurs si N_local est fourni */
+template<typename T>
+static void fragmentsArete(const T* D_local, const int* N_local, const Distribution& d,
+                           int u, int v, T* col_u, int* colN_u, T* lig_v) {
+    int nb = d.nb;
+    int U = u / nb, V = v / nb;
+    if (d.g.py == U % d.g.pc) {
+        int lj = U / d.g.pc;
+        for (int li = 0; li < d.lignes; li++) {
+            const T* B = blocLocal(const_cast<T*>(D_local), d, li, lj);
+            for (int i = 0; i < nb; i++) col_u[li*nb + i] = B[i*nb + u % nb];
+            if (N_local) {
+                const int* S = blocLocal(const_cast<int*>(N_local), d, li, lj);
+                for (int i = 0; i < nb; i++) colN_u[li*nb + i] = S[i*nb + u % nb];
+            }
+        }
+    }
+    MPI_Bcast(col_u, d.lignes*nb, typeMPI<T>(), U % d.g.pc, d.g.ligne);
+    if (N_local)
+        MPI_Bcast(colN_u, d.lignes*nb, MPI_INT, U % d.g.pc, d.g.ligne);
+
+    if (d.g.px == V % d.g.pr) {
+        int li = V / d.g.pr;
+        for (int lj = 0; lj < d.colonnes; lj++)
+            copy_n(blocLocal(const_cast<T*>(D_local), d, li, lj) + (v % nb)*nb, nb, lig_v + lj*nb);
+    }
+    MPI_Bcast(lig_v, d.colonnes*nb, typeMPI<T>(), V % d.g.pr, d.g.colonne);
+}
 
-        // ======== PHASE 5 : Mise à jour AUTRES blocs ========
-        if(px != k && py != k){
-            // Maintenant row_block = bloc[k, py] et col_block = bloc[px, k]
-            #pragma omp parallel for collapse(2) 
-            for(int kk=0; kk<block_size; kk++){
-                for(int i=0; i<block_size; i++){
-                    for(int j=0; j<block_size; j++){
-                        if(col_block[i*block_size+kk] < INF && 
-                           row_block[kk*block_size+j] < INF){
-                            int new_dist = col_block[i*block_size+kk] + 
-                                         row_block[kk*block_size+j];
-                            if(new_dist < A(D_local,block_size,i,j)){
-                                A(D_local,block_size,i,j) = new_dist;
-                            }
-                        }
+template<typename T>
+void insererArete(T* D_local, const Distribution& dist, int u, int v, T w, int* N_local) {
+    int nb = dist.nb;
+    // Aucun effet si w n'améliore pas D[u][v] : un seul élément à diffuser
+    int coords[2] = {(u / nb) % dist.g.pr, (v / nb) % dist.g.pc};
+    int proprio;
+    MPI_Cart_rank(dist.g.grille, coords, &proprio);
+    T d_uv = 0;
+    if (dist.g.px == coords[0] && dist.g.py == coords[1])
+        d_uv = blocLocal(D_local, dist, (u / nb) / dist.g.pr, (v / nb) / dist.g.pc)[(u % nb)*nb + v % nb];
+    MPI_Bcast(&d_uv, 1, typeMPI<T>(), proprio, dist.g.grille);
+    if (w >= d_uv) return;
+
+    vector<T> col_u((long)dist.lignes*nb), lig_v((long)dist.colonnes*nb);
+    vector<int> colN_u(N_local ? (long)dist.lignes*nb : 0);
+    fragmentsArete(D_local, N_local, dist, u, v, col_u.data(), colN_u.data(), lig_v.data());
+
+    // D[i][j] = min(D[i][j], D[i][u] + w + D[v][j]) : un seul passage suffit,
+    // D[i][u] et D[v][j] ne changent pas (pas de cycle négatif)
+    #pragma omp parallel for schedule(dynamic)
+    for (int li = 0; li < dist.lignes; li++)
+        for (int i = 0; i < nb; i++) {
+            T a = col_u[li*nb + i];
+            if (a >= Poids<T>::infini()) continue;
+            a = Poids<T>::plus(a, w);
+            int ig = blocGlobalLigne(dist, li)*nb + i;
+            int suivant = (ig == u) ? v : (N_local ? colN_u[li*nb + i] : -1);
+            for (int lj = 0; lj < dist.colonnes; lj++) {
+                T* Bi = blocLocal(D_local, dist, li, lj) + i*nb;
+                int* Si = N_local ? blocLocal(N_local, dist, li, lj) + i*nb : nullptr;
+                const T* b = lig_v.data() + lj*nb;
+                if (!Si) {
+                    #pragma omp simd
+                    for (int j = 0; j < nb; j++) {
+                        T c = Poids<T>::plus(a, b[j]);
+                        Bi[j] = c < Bi[j] ? c : Bi[j];
+                    }
+                    continue;
+                }
+                for (int j = 0; j < nb; j++) {
+                    T c = Poids<T>::plus(a, b[j]);
+                    if (c < Bi[j]) {
+                        Bi[j] = c;
+                        Si[j] = suivant;
                     }
                 }
             }
         }
+}
 
-        MPI_Barrier(MPI_COMM_WORLD);
+template<typename T>
+void insererAretes(T* D_local, const Distribution& dist, const int* aretes, long nb_aretes,
+                   int* N_local) {
+    for (long a = 0; a < nb_aretes; a++)
+        insererArete(D_local, dist, aretes[3*a], aretes[3*a+1], (T)aretes[3*a+2], N_local);
+}
+
+template<typename T>
+int ajouterSommet(T** D_local, Distribution* dist, const int* aretes, long nb_aretes,
+                  int** N_local) {
+    Distribution& d = *dist;
+    int x = d.n, nb = d.nb;
+    if (x == d.nblocs*nb) {
+        // Plus de place dans la complétion : un bloc-ligne et un bloc-colonne
+        // de plus. Un bloc global garde ses indices locaux (I / pr, J / pc),
+        // seuls les nombres de blocs locaux changent.
+        Distribution nd = d;
+        nd.nblocs = d.nblocs + 1;
+        nd.lignes = nbBlocsLocaux(nd.nblocs, d.g.px, d.g.pr);
+        nd.colonnes = nbBlocsLocaux(nd.nblocs, d.g.py, d.g.pc);
+        T* D2 = new T[tailleLocale(nd)];
+        int* N2 = N_local && *N_local ? new int[tailleLocale(nd)] : nullptr;
+        if (N2) fill_n(N2, tailleLocale(nd), -1);
+        for (int li = 0; li < d.lignes; li++)
+            for (int lj = 0; lj < d.colonnes; lj++) {
+                copy_n(blocLocal(*D_local, d, li, lj), nb*nb, blocLocal(D2, nd, li, lj));
+                if (N2) copy_n(blocLocal(*N_local, d, li, lj), nb*nb, blocLocal(N2, nd, li, lj));
+            }
+        remplirComplement(D2, nd, nullptr);
+        delete[] *D_local;
+        *D_local = D2;
+        if (N2) {
+            delete[] *N_local;
+            *N_local = N2;
+        }
+        d = nd;
     }
+    // Le sommet x est d'abord isolé (ligne et colonne de complétion : infini,
+    // 0 sur la diagonale), puis ses arêtes sont insérées une à une
+    d.n = x + 1;
+    insererAretes(*D_local, d, aretes, nb_aretes, N_local ? *N_local : nullptr);
+    return x;
+}
 
-    delete[] pivot;
-    delete[] row_block;
-    delete[] col_block;
+template<typename T>
+void largeursDepuisDistances(T* D_local, const Distribution& dist, const Triangle* tri) {
+    int nb = dist.nb;
+    for (int li = 0; li < dist.lignes; li++)
+        for (int lj = 0; lj < dist.colonnes; lj++) {
+            int i0 = blocGlobalLigne(dist, li)*nb, j0 = blocGlobalColonne(dist, lj)*nb;
+            T* B = blocStocke(D_local, dist, tri, li, lj);
+            if (!B) continue;
+            for (int i = 0; i < nb; i++)
+                for (int j = 0; j < nb; j++) {
+                    T& x = B[i*nb + j];
+                    if (i0+i == j0+j) x = MaxMin<T>::unite();
+                    else if (x >= Poids<T>::infini()) x = MaxMin<T>::neutre();
+                }
+        }
+}
 
-    return rassemblerMatrice(D_local, nb_nodes, block_size, p_sqrt, root, pid);
+long tailleCompacte(const Distribution& dist) {
+    return (long)dist.lignes * dist.colonnes * dist.nb * Accessibilite::mots(dist.nb);
 }
+
+template<typename T>
+uint64_t* compacterAccessibilite(const T* D_local, const Distribution& dist) {
+    int nb = dist.nb, w = Accessibilite::mots(nb);
+    uint64_t* R = new uint64_t[tailleCompacte(dist)]();
+    for (int li = 0; li < dist.lignes; li++)
+        for (int lj = 0; lj < dist.colonnes; lj++) {
+            const T* B = blocLocal(const_cast<T*>(D_local), dist, li, lj);
+            uint64_t* Rb = R + ((long)li*dist.colonnes + lj)*nb*w;
+            for (int i = 0; i < nb; i++)
+                for (int j = 0; j < nb; j++)
+                    if (B[i*nb + j] < Poids<T>::infini())
+                        Rb[i*w + j/64] |= (uint64_t)1 << (j%64);
+        }
+    return R;
+}
+
+void deplierAccessibilite(const uint64_t* R_local, const Distribution& dist, int* A_local) {
+    int nb = dist.nb, w = Accessibilite::mots(nb);
+    for (long b = 0; b < (long)dist.lignes*dist.colonnes; b++) {
+        const uint64_t* Rb = R_local + b*nb*w;
+        int* Ab = A_local + b*nb*nb;
+        for (int i = 0; i < nb; i++)
+            for (int j = 0; j < nb; j++)
+                Ab[i*nb + j] = (Rb[i*w + j/64] >> (j%64)) & 1;
+    }
+}
+
+/* Instanciations pour les types de poids de Poids.hpp */
+#define INSTANCIER_FLOYD_BLOCS(T) \
+    template void decouperMatrice<T>(T*, T*, const Distribution&, int, const Triangle*); \
+    template T* rassemblerMatrice<T>(T*, const Distribution&, int, const Triangle*); \
+    template void construireLocale<T>(T*, const Distribution&, const int*, long, const Triangle*); \
+    template void distribuerAretes<T>(const int*, long, T*, const Distribution&, int, const Triangle*); \
+    template void floydBlocsLocal<T>(T*, const Distribution&, int, bool, int*, PointReprise*, TempsPhases*); \
+    template T* floydBlocsHybrid<T>(T*, const Distribution&, int, int, bool, int*, PointReprise*, TempsPhases*); \
+    template void initialiserSuivants<T>(const T*, int*, const Distribution&); \
+    template int floydHorsMemoire<T>(const int*, long, const Distribution&, int, int, HorsMemoire*); \
+    template int ecrireResultat<T>(const char*, const T*, const Distribution&); \
+    template int ecrireResultatHorsMemoire<T>(const char*, HorsMemoire*, const Distribution&); \
+    template void fermetureBlocsLocal<MinPlus<T> >(T*, const Distribution&, int, bool, int*, PointReprise*, TempsPhases*); \
+    template void fermetureBlocsLocal<MaxMin<T> >(T*, const Distribution&, int, bool, int*, PointReprise*, TempsPhases*); \
+    template void fermetureFluxLocal<MinPlus<T> >(T*, const Distribution&, int, int, TempsPhases*); \
+    template void fermetureFluxLocal<MaxMin<T> >(T*, const Distribution&, int, int, TempsPhases*); \
+    template void fermetureCouchesLocal<MinPlus<T> >(T*, const Distribution&, int, int, TempsPhases*); \
+    template void fermetureCouchesLocal<MaxMin<T> >(T*, const Distribution&, int, int, TempsPhases*); \
+    template void fermetureSymetriqueLocal<MinPlus<T> >(T*, const Distribution&, const Triangle&, int, TempsPhases*); \
+    template void fermetureSymetriqueLocal<MaxMin<T> >(T*, const Distribution&, const Triangle&, int, TempsPhases*); \
+    template void largeursDepuisDistances<T>(T*, const Distribution&, const Triangle*); \
+    template uint64_t* compacterAccessibilite<T>(const T*, const Distribution&); \
+    template void insererArete<T>(T*, const Distribution&, int, int, T, int*); \
+    template void insererAretes<T>(T*, const Distribution&, const int*, long, int*); \
+    template int ajouterSommet<T>(T**, Distribution*, const int*, long, int**);
+INSTANCIER_FLOYD_BLOCS(int16_t)
+INSTANCIER_FLOYD_BLOCS(int32_t)
+INSTANCIER_FLOYD_BLOCS(int64_t)
+INSTANCIER_FLOYD_BLOCS(float)
+template void fermetureBlocsLocal<Accessibilite>(uint64_t*, const Distribution&, int, bool, int*,
+                                                 PointReprise*, TempsPhases*);
+template void fermetureFluxLocal<Accessibilite>(uint64_t*, const Distribution&, int, int, TempsPhases*);
+template void fermetureCouchesLocal<Accessibilite>(uint64_t*, const Distribution&, int, int, TempsPhases*);
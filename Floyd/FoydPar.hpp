@@ -8,62 +8,672 @@
 #include <algorithm>
 #include <iomanip>
 #include "ForGraph.hpp"
+#include "SemiAnneau.hpp"
+#include "StockTuiles.hpp"
 
 using namespace std;
 
-inline int& A(int* B, int b, int i, int j);
+/**
+ * @brief Taille des sous-tuiles traitées par une tâche OpenMP à l'intérieur
+ *        d'un bloc (modifiable à la compilation : -DFLOYD_SOUS_TUILE=128)
+ */
+#ifndef FLOYD_SOUS_TUILE
+#define FLOYD_SOUS_TUILE 64
+#endif
+
+/**
+ * @brief Sauts de tuiles de la fermeture par blocs (1 par défaut, 0 pour
+ *        les désactiver à la compilation : -DFLOYD_SAUT_TUILES=0). Chaque
+ *        bande de FLOYD_SOUS_TUILE lignes d'un bloc a un résumé (plus petit
+ *        et plus grand élément), tenu à jour avec les blocs et diffusé avec
+ *        les panneaux : une mise à jour de la phase 5 que les résumés
+ *        déclarent sans effet n'est pas calculée, et les blocs des panneaux
+ *        qui ne contiennent que le neutre (infini en (min,+)) ne sont pas
+ *        diffusés.
+ */
+#ifndef FLOYD_SAUT_TUILES
+#define FLOYD_SAUT_TUILES 1
+#endif
+
+/**
+ * @brief Type MPI d'un poids (ou d'un mot de Accessibilite)
+ */
+template<typename T> MPI_Datatype typeMPI();
+template<> inline MPI_Datatype typeMPI<int16_t>() { return MPI_INT16_T; }
+template<> inline MPI_Datatype typeMPI<int32_t>() { return MPI_INT32_T; }
+template<> inline MPI_Datatype typeMPI<int64_t>() { return MPI_INT64_T; }
+template<> inline MPI_Datatype typeMPI<float>() { return MPI_FLOAT; }
+template<> inline MPI_Datatype typeMPI<uint64_t>() { return MPI_UINT64_T; }
+
+/**
+ * @brief Grille cartésienne pr x pc des processus et ses sous-communicateurs
+ *        de ligne et de colonne
+ */
+struct GrilleProcessus {
+    MPI_Comm grille;   /**< Communicateur cartésien (rangs identiques à ceux du communicateur parent) */
+    MPI_Comm ligne;    /**< Processus de la même ligne, rang = colonne py */
+    MPI_Comm colonne;  /**< Processus de la même colonne, rang = ligne px */
+    int pr, pc;        /**< Dimensions de la grille */
+    int px, py;        /**< Coordonnées du processus courant */
+};
+
+/**
+ * @brief Crée la grille cartésienne (MPI_Cart_create) et les
+ *        sous-communicateurs de ligne et de colonne (MPI_Cart_sub)
+ * 
+ * @param pr Nombre de lignes de processus
+ * @param pc Nombre de colonnes de processus (pr * pc = nombre de processus)
+ * @param comm Processus de la grille (MPI_COMM_WORLD, ou une couche de la
+ *        fermeture 2.5D)
+ * @return GrilleProcessus à libérer avec libererGrille
+ */
+GrilleProcessus creerGrille(int pr, int pc, MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Libère les communicateurs de la grille
+ */
+void libererGrille(GrilleProcessus& g);
+
+/**
+ * @brief Distribution 2D bloc-cyclique (type ScaLAPACK) d'une matrice n x n.
+ *
+ * La matrice est découpée en nblocs x nblocs blocs de taille nb ; le bloc
+ * global (I, J) appartient au processus (I % pr, J % pc) où il est rangé
+ * comme bloc local (I / pr, J / pc). Les blocs locaux sont contigus,
+ * rangés ligne par ligne : le bloc (li, lj) commence à
+ * D_local + (li*colonnes + lj)*nb*nb. Les lignes et colonnes au-delà de n
+ * (dernier bloc incomplet) sont complétées par l'infini du type de poids
+ * (0 sur la diagonale), ce qui ne modifie aucun plus court chemin.
+ *
+ * La distribution ne dépend pas du type des poids : les fonctions de
+ * calcul sont instanciées pour chaque type de Poids.hpp (int16_t, int32_t,
+ * int64_t, float), int restant le type par défaut.
+ */
+struct Distribution {
+    GrilleProcessus g; /**< Grille de processus */
+    int n;             /**< Nombre de noeuds */
+    int nb;            /**< Taille d'un bloc */
+    int nblocs;        /**< Nombre de blocs par dimension (ceil(n / nb)) */
+    int lignes;        /**< Nombre de lignes de blocs locales */
+    int colonnes;      /**< Nombre de colonnes de blocs locales */
+};
+
+/**
+ * @brief Crée la distribution bloc-cyclique (opération collective)
+ * 
+ * @param n Nombre de noeuds
+ * @param nb Taille de bloc (0 = min(256, ceil(n / max(pr, pc))))
+ * @param pr Lignes de la grille (0 = choix automatique par MPI_Dims_create)
+ * @param pc Colonnes de la grille (0 = choix automatique)
+ * @param comm Processus de la grille
+ * @return Distribution à libérer avec libererDistribution
+ */
+Distribution creerDistribution(int n, int nb, int pr, int pc, MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Libère les communicateurs de la distribution
+ */
+void libererDistribution(Distribution& d);
+
+/**
+ * @brief Nombre d'éléments du tableau local D_local
+ */
+inline long tailleLocale(const Distribution& d) {
+    return (long)d.lignes * d.colonnes * d.nb * d.nb;
+}
+
+/**
+ * @brief Adresse du bloc local (li, lj) dans D_local
+ */
+template<typename T>
+inline T* blocLocal(T* D_local, const Distribution& d, int li, int lj) {
+    return D_local + ((long)li * d.colonnes + lj) * d.nb * d.nb;
+}
+
+/**
+ * @brief Indice global du bloc de la ligne locale li (resp. colonne locale lj)
+ */
+inline int blocGlobalLigne(const Distribution& d, int li) { return li * d.g.pr + d.g.px; }
+inline int blocGlobalColonne(const Distribution& d, int lj) { return lj * d.g.pc + d.g.py; }
+
+/**
+ * @brief Blocs locaux du mode symétrique (graphe non orienté : D = Dᵀ).
+ *
+ * Seuls les blocs (I, J) avec I <= J sont stockés, chez leur propriétaire
+ * de la distribution bloc-cyclique (I % pr, J % pc) ; le bloc (J, I) est la
+ * transposée du bloc (I, J). Restreinte au triangle, la distribution
+ * cyclique reste équilibrée : chaque processus garde environ
+ * nblocs² / (2 pr pc) blocs, quelle que soit la grille. Les blocs stockés
+ * de la ligne locale li sont les colonnes locales lj >= premiere[li],
+ * contigus et rangés ligne par ligne comme dans D_local.
+ */
+struct Triangle {
+    vector<int> premiere;   /**< Première colonne locale stockée de chaque ligne locale */
+    vector<long> debut;     /**< lignes + 1 : blocs stockés avant chaque ligne locale */
+};
+
+/**
+ * @brief Blocs du triangle supérieur possédés par le processus courant
+ */
+Triangle creerTriangle(const Distribution& d);
+
+/**
+ * @brief Nombre d'éléments du tableau local symétrique
+ */
+inline long tailleTriangle(const Distribution& d, const Triangle& t) {
+    return t.debut.back() * d.nb * d.nb;
+}
+
+/**
+ * @brief Adresse du bloc local (li, lj) dans le tableau symétrique
+ *        (nullptr pour un bloc sous la diagonale)
+ */
+template<typename T>
+inline T* blocTriangle(T* X, const Distribution& d, const Triangle& t, int li, int lj) {
+    return lj < t.premiere[li] ? nullptr : X + (t.debut[li] + lj - t.premiere[li]) * d.nb * d.nb;
+}
 
 /**
  * @brief Découpe la matrice globale en blocs et les distribue
+ *
+ * Aucune copie intermédiaire : le root envoie directement depuis D avec un
+ * type dérivé (sous-tableaux MPI_Type_create_subarray) par processus, et
+ * chaque processus reçoit directement dans ses blocs locaux.
  * 
- * @param D Matrice globale (sur processus root)
- * @param D_local Bloc local (sortie)
- * @param n Taille de la matrice globale
- * @param block_size Taille d'un bloc
- * @param p_sqrt Racine carrée du nombre de processus
+ * @param D Matrice globale n x n (sur processus root)
+ * @param D_local Blocs locaux (sortie, tailleLocale(dist) éléments)
+ * @param dist Distribution bloc-cyclique
  * @param root Processus racine
- * @param pid Identifiant du processus courant
+ * @param tri Mode symétrique : seuls les blocs du triangle supérieur sont
+ *        envoyés, dans un tableau de tailleTriangle(dist, *tri) éléments
+ */
+template<typename T>
+void decouperMatrice(T* D, T* D_local, const Distribution& dist, int root,
+                     const Triangle* tri = nullptr);
+
+/**
+ * @brief Rassemble les blocs distribués en matrice globale, reçus directement
+ *        à leur place dans la matrice n x n du root (types dérivés)
+ * 
+ * @param D_local Blocs locaux
+ * @param dist Distribution bloc-cyclique
+ * @param root Processus racine
+ * @param tri Mode symétrique : le root reçoit le triangle supérieur et en
+ *        recopie la transposée sous la diagonale
+ * @return T* Matrice globale n x n (NULL si pid != root)
+ */
+template<typename T>
+T* rassemblerMatrice(T* D_local, const Distribution& dist, int root,
+                     const Triangle* tri = nullptr);
+
+/**
+ * @brief Construit les blocs locaux directement à partir d'arêtes, sans
+ *        passer par une matrice n x n (équivalent de InitDk sur les blocs locaux)
+ *
+ * Les arêtes dont aucune des entrées (u,v), (v,u) n'est locale sont ignorées.
+ * 
+ * @param D_local Blocs locaux (sortie, tailleLocale(dist) éléments)
+ * @param dist Distribution bloc-cyclique
+ * @param aretes Triplets (u, v, poids), arêtes non orientées
+ * @param nb_aretes Nombre de triplets
+ * @param tri Mode symétrique (blocs du triangle supérieur seulement)
  */
-void decouperMatrice(int* D, int* D_local,
-                     int n, int block_size, int p_sqrt,
-                     int root, int pid);
+template<typename T>
+void construireLocale(T* D_local, const Distribution& dist,
+                      const int* aretes, long nb_aretes, const Triangle* tri = nullptr);
 
 /**
- * @brief Rassemble les blocs distribués en matrice globale
+ * @brief Mode entièrement distribué : le root répartit les arêtes entre les
+ *        propriétaires des blocs (MPI_Scatterv), puis chaque processus
+ *        construit ses blocs locaux avec construireLocale. Le root ne
+ *        stocke jamais de matrice n x n.
  * 
- * @param D_local Bloc local
- * @param n Taille de la matrice globale
- * @param block_size Taille d'un bloc
- * @param p_sqrt Racine carrée du nombre de processus
+ * @param aretes Triplets (u, v, poids) (significatif sur root uniquement)
+ * @param nb_aretes Nombre de triplets (significatif sur root uniquement)
+ * @param D_local Blocs locaux (sortie)
+ * @param dist Distribution bloc-cyclique
  * @param root Processus racine
- * @param pid Identifiant du processus courant
- * @return int* Matrice globale (NULL si pid != root)
+ * @param tri Mode symétrique (blocs du triangle supérieur seulement)
  */
-int* rassemblerMatrice(int* D_local,
-                       int n, int block_size, int p_sqrt,
-                       int root, int pid);
+template<typename T>
+void distribuerAretes(const int* aretes, long nb_aretes, T* D_local,
+                      const Distribution& dist, int root, const Triangle* tri = nullptr);
 
 void afficherBloc(int* D_local, int block_size,
                   int pid, int nprocs, const string &titre);
 
+/**
+ * @brief Phases mesurées de la fermeture par blocs
+ */
+enum PhaseFloyd { PHASE_PANNEAUX, PHASE_DIFFUSION, PHASE_RESTE, PHASE_ATTENTE, NB_PHASES };
+
+/**
+ * @brief Temps cumulés (secondes) des phases de la fermeture par blocs sur
+ *        le processus courant. Avec l'anticipation les phases se
+ *        recouvrent : le temps est compté dans la phase de l'appel en cours,
+ *        et à l'étape qu'il traite (les panneaux K+1, calculés pendant
+ *        l'étape K, comptent pour l'étape K+1).
+ *
+ * Le coût de la mesure est de quelques MPI_Wtime par étape. Avec
+ * synchroniser, une MPI_Barrier sur la grille précède la phase 4 (sans
+ * anticipation seulement) : le temps passé à attendre les processus en
+ * retard y est isolé du transfert, au prix d'une synchronisation de plus.
+ */
+struct TempsPhases {
+    double panneaux = 0;   /**< Phases 1 à 3 : calcul du pivot, de la ligne et de la colonne de blocs K */
+    double diffusion = 0;  /**< Diffusions du pivot et des panneaux, attentes des MPI_Ibcast */
+    double reste = 0;      /**< Phase 5 : autres blocs */
+    double attente = 0;    /**< Barrière avant la phase 4 (si synchroniser) */
+    bool synchroniser = false; /**< Isoler l'attente dans une barrière */
+    bool par_etape = false;    /**< Remplir etapes */
+    vector<double> etapes; /**< (sortie) NB_PHASES durées par étape K, dans l'ordre de PhaseFloyd */
+    long bandes_calculees = 0; /**< (sortie) Bandes de la phase 5 calculées */
+    long bandes_sautees = 0;   /**< (sortie) Bandes de la phase 5 sautées (FLOYD_SAUT_TUILES) */
+    long blocs_non_diffuses = 0; /**< (sortie) Blocs vides des panneaux non diffusés */
+};
+
+/**
+ * @brief Une durée sur l'ensemble des processus ; desequilibre = max /
+ *        moyenne - 1 (0 : charge parfaitement répartie)
+ */
+struct StatistiquesPhase {
+    double min, moyenne, max, desequilibre;
+};
+
+/**
+ * @brief Réduit les temps des phases de tous les processus sur le root
+ *        (collectif)
+ *
+ * @param stats (sortie, root) NB_PHASES + 1 statistiques : les phases dans
+ *        l'ordre de PhaseFloyd, puis leur somme
+ */
+void reduireTempsPhases(const TempsPhases& t, StatistiquesPhase* stats, MPI_Comm comm, int root);
+
+/**
+ * @brief Rassemble les temps de chaque processus sur le root, qui les écrit
+ *        en CSV : une ligne par processus et par étape K (si par_etape), plus
+ *        une ligne "total" par processus (collectif)
+ *
+ * @param grille Grille du calcul (coordonnées des processus)
+ * @return int 0 si succès, -1 si le root ne peut écrire le fichier
+ */
+int ecrireTempsRangs(const char* f, const TempsPhases& t, const GrilleProcessus& grille, int root);
+
+/**
+ * @brief Points de reprise de la fermeture par blocs (MPI-IO).
+ *
+ * Toutes les `intervalle` étapes K, les blocs locaux de chaque processus
+ * (puis ses successeurs s'il y en a) sont écrits dans un seul fichier
+ * partagé, à la suite dans l'ordre des rangs, derrière un en-tête de 64
+ * octets qui donne l'étape K à reprendre, n, nb, la grille, le type des
+ * éléments, le semi-anneau et une empreinte des blocs de départ (graphe
+ * d'entrée). Le fichier est écrit en F.tmp
+ * (MPI_File_write_at_all) puis renommé en F : une panne pendant l'écriture
+ * laisse intact le point précédent.
+ *
+ * La reprise exige les mêmes n, nb, grille PRxPC, type, semi-anneau,
+ * présence des successeurs et la même empreinte des blocs de départ ;
+ * sinon (ou si F n'existe pas) le point est ignoré et le calcul part de
+ * K = 0. Avec l'anticipation, le pipeline est vidé à chaque point de reprise.
+ */
+struct PointReprise {
+    const char* fichier;    /**< Fichier partagé */
+    int intervalle;         /**< Étapes K entre deux écritures (0 = aucune) */
+    bool reprendre;         /**< Relire fichier avant le calcul */
+    int k_depart;           /**< (sortie) Étape de reprise, 0 sans reprise */
+    int ecritures;          /**< (sortie) Points écrits */
+    double temps_ecriture;  /**< (sortie) Temps passé à écrire, sur ce processus */
+    double temps_lecture;   /**< (sortie) Temps de relecture, sur ce processus */
+    long long octets;       /**< (sortie) Taille d'un point de reprise */
+};
+
+/**
+ * @brief Fermeture par blocs sur les blocs locaux pour le semi-anneau S
+ *        (MinPlus<T>, MaxMin<T> ou Accessibilite, voir SemiAnneau.hpp) :
+ *        même distribution, mêmes diffusions des pivots et mêmes phases
+ *        que Floyd-Warshall, seuls les noyaux des blocs changent.
+ *
+ * @param X_local Blocs locaux (nb lignes de S::mots(nb) éléments chacun),
+ *        modifiés en place
+ * @param dist Distribution bloc-cyclique
+ * @param num_threads Nombre de threads OpenMP (0 = automatique)
+ * @param anticipation Mode look-ahead (voir floydBlocsHybrid)
+ * @param N_local Successeurs, en (min,+) uniquement (nullptr sinon)
+ * @param reprise Points de reprise (nullptr : aucun)
+ * @param temps Temps des phases, ajoutés à ceux déjà présents (nullptr : aucun)
+ */
+template<typename S>
+void fermetureBlocsLocal(typename S::T* X_local, const Distribution& dist,
+                         int num_threads, bool anticipation = false, int* N_local = nullptr,
+                         PointReprise* reprise = nullptr, TempsPhases* temps = nullptr);
+
+/**
+ * @brief Étapes K dont les panneaux peuvent être reçus à l'avance par la
+ *        fermeture par flot de données (modifiable à la compilation)
+ */
+#ifndef FLOYD_FENETRE_FLUX
+#define FLOYD_FENETRE_FLUX 4
+#endif
+
+/**
+ * @brief Fermeture par blocs pilotée par les données, sans aucune
+ *        collective : même résultat que fermetureBlocsLocal
+ *
+ * Chaque bloc local reçoit une tâche par étape K : fermeture du pivot,
+ * mise à jour d'un bloc de la ligne ou de la colonne K (panneaux), ou
+ * mise à jour C[I][J] ⊕= C[I][K] ⊗ C[K][J]. Une tâche part dès que ses
+ * entrées de l'étape K sont là ; le pivot et les panneaux sont envoyés en
+ * point à point (MPI_Isend, étiquette dérivée de K) à leurs seuls
+ * consommateurs. Un processus rapide continue donc sur les étapes
+ * suivantes tant que ses données le permettent, au lieu d'attendre à
+ * chaque diffusion les processus les plus lents.
+ *
+ * Les tâches prêtes sont exécutées par lots d'une même étape (bandes de
+ * lignes réparties sur les threads), celles qui alimentent les panneaux
+ * K+1 locaux d'abord. Les réceptions sont postées pour `fenetre` étapes
+ * d'avance ; un bloc de la ligne ou de la colonne K n'est réécrit qu'une
+ * fois l'étape K terminée localement (lectures et envois compris).
+ *
+ * @param X_local Blocs locaux, modifiés en place
+ * @param dist Distribution bloc-cyclique
+ * @param num_threads Nombre de threads OpenMP (0 = automatique)
+ * @param fenetre Étapes reçues à l'avance (>= 1)
+ * @param temps Temps des phases (nullptr : aucun) ; attente = temps bloqué
+ *        dans MPI_Waitany faute de tâche prête
+ */
+template<typename S>
+void fermetureFluxLocal(typename S::T* X_local, const Distribution& dist, int num_threads,
+                        int fenetre = FLOYD_FENETRE_FLUX, TempsPhases* temps = nullptr);
+
+/**
+ * @brief Fermeture 2.5D : même résultat que fermetureBlocsLocal, avec moins
+ *        de communications par processus en échange de c copies de la
+ *        matrice (opération collective).
+ *
+ * Les P processus forment c couches de P/c processus (rangs consécutifs),
+ * chacune une grille 2D (MPI_Dims_create) qui garde toute la matrice en
+ * bloc-cyclique avec la même taille de bloc. La fermeture est celle de
+ * Kleene, récursive sur les intervalles de blocs : A11 fermé, A12 = A11 ⊗
+ * A12, A21 = A21 ⊗ A11, A22 ⊕= A21 ⊗ A12, A22 fermé, puis A21 = A22 ⊗ A21,
+ * A12 = A12 ⊗ A22 et A11 ⊕= A12 ⊗ A21. Chaque produit est un SUMMA dont la
+ * dimension K est partagée entre les couches (bloc K à la couche
+ * K mod c) ; les c résultats partiels sont ensuite réduits par ⊕
+ * (MPI_Allreduce : MPI_MIN, MPI_MAX ou MPI_BOR selon S). Les mises à jour
+ * en place restent exactes car ⊕ est idempotent et les valeurs ne font
+ * que décroître (au sens de S) vers le résultat. Les blocs diagonaux sont
+ * fermés par chaque couche, qui en a la même copie.
+ *
+ * Les panneaux diffusés par une couche ne portent que ses blocs K, soit
+ * O(n² / √(cP)) éléments reçus par processus au lieu de O(n² / √P) ; la
+ * réduction entre couches de chaque produit coûte O(c n² / P). Les blocs
+ * de dist sont recopiés dans les c couches en entrée et rapatriés en
+ * sortie (MPI_Alltoallv de blocs entiers).
+ *
+ * @param X_local Blocs locaux de dist, modifiés en place
+ * @param dist Distribution bloc-cyclique sur tous les processus
+ * @param couches Facteur de réplication c (diviseur du nombre de processus)
+ * @param num_threads Nombre de threads OpenMP (0 = automatique)
+ * @param temps Temps des phases (nullptr : aucun) : panneaux = fermeture des
+ *        blocs diagonaux, diffusion = panneaux des produits, réductions entre
+ *        couches et recopies, reste = produits ; pas de détail par étape
+ */
+template<typename S>
+void fermetureCouchesLocal(typename S::T* X_local, const Distribution& dist, int couches,
+                           int num_threads, TempsPhases* temps = nullptr);
+
+/**
+ * @brief Fermeture par blocs symétrique (graphe non orienté) : même
+ *        résultat que fermetureBlocsLocal sur le triangle supérieur, pour
+ *        MinPlus<T> ou MaxMin<T> (opération collective).
+ *
+ * Seuls les blocs (I, J), I <= J, sont stockés (voir Triangle) et mis à
+ * jour ; un bloc sous la diagonale est lu comme la transposée de son
+ * symétrique. À l'étape K, le pivot est fermé, puis les blocs (K, J > K)
+ * et (I < K, K) : ensemble, ils forment la ligne de blocs K entière (la
+ * colonne K en est la transposée), soit un panneau au lieu de deux. Les
+ * blocs (K, J > K) sont diffusés le long des colonnes de la grille et les
+ * blocs (I < K, K) le long des lignes, comme en 2D ; les facteurs
+ * manquants (C[I][K] pour I > K, C[K][J] pour J < K) sont les transposées
+ * de blocs déjà reçus par un processus de la même ligne (resp. colonne) de
+ * la grille, qui les échangent par un MPI_Allgatherv. La phase 5 ne touche
+ * que les blocs du triangle : mémoire, calcul des panneaux et de la
+ * phase 5 sont divisés par deux environ.
+ *
+ * @param X Blocs du triangle (tailleTriangle(dist, tri) éléments), modifiés en place
+ * @param dist Distribution bloc-cyclique
+ * @param tri Blocs stockés (creerTriangle(dist))
+ * @param num_threads Nombre de threads OpenMP (0 = automatique)
+ * @param temps Temps des phases (nullptr : aucun) ; panneaux = pivot et
+ *        blocs (K, J), (I, K), diffusion = diffusions et échanges des transposées
+ */
+template<typename S>
+void fermetureSymetriqueLocal(typename S::T* X, const Distribution& dist, const Triangle& tri,
+                              int num_threads, TempsPhases* temps = nullptr);
+
+/**
+ * @brief Floyd-Warshall par blocs sur les blocs locaux, sans rassemblement :
+ *        en sortie D_local contient les blocs locaux de la matrice des distances
+ * 
+ * @param D_local Blocs locaux de la matrice (modifiés en place)
+ * @param dist Distribution bloc-cyclique
+ * @param num_threads Nombre de threads OpenMP (0 = automatique)
+ * @param anticipation Mode look-ahead (voir floydBlocsHybrid)
+ * @param N_local Successeurs locaux (même disposition que D_local, initialisés
+ *        par initialiserSuivants), mis à jour avec D_local ; nullptr si inutile
+ * @param reprise Points de reprise (nullptr : aucun)
+ * @param temps Temps des phases (nullptr : aucun)
+ */
+template<typename T>
+void floydBlocsLocal(T* D_local, const Distribution& dist,
+                     int num_threads, bool anticipation = false, int* N_local = nullptr,
+                     PointReprise* reprise = nullptr, TempsPhases* temps = nullptr);
+
 /**
  * @brief Algorithme de Floyd-Warshall par blocs (VERSION HYBRIDE MPI+OpenMP)
  * 
- * Utilise MPI pour la distribution des blocs et OpenMP pour paralléliser
- * les calculs au sein de chaque bloc.
+ * Utilise MPI pour la distribution bloc-cyclique des blocs et OpenMP pour
+ * paralléliser les calculs sur les blocs locaux.
  * 
- * @param D_local Bloc local de la matrice
- * @param nb_nodes Nombre de nœuds du graphe
- * @param p_sqrt Racine carrée du nombre de processus
- * @param pid Identifiant du processus courant
+ * @param D_local Blocs locaux de la matrice
+ * @param dist Distribution bloc-cyclique
  * @param root Processus racine
  * @param num_threads Nombre de threads OpenMP (0 = automatique)
- * @return int* Matrice globale (NULL si pid != root)
+ * @param anticipation Mode look-ahead : les panneaux de l'étape k+1 sont
+ *        calculés en priorité et diffusés par MPI_Ibcast pendant la phase 5
+ *        de l'étape k
+ * @param N_local Successeurs locaux mis à jour en même temps (nullptr si
+ *        inutile) ; rassemblerMatrice(N_local, ...) donne la matrice next
+ * @param reprise Écriture périodique de l'état et reprise après une
+ *        interruption (voir PointReprise ; nullptr : aucune)
+ * @param temps Temps des phases (nullptr : aucun)
+ * @return T* Matrice globale (NULL si pid != root)
  * 
+ * @note Le pivot n'est diffusé qu'à la ligne et à la colonne de processus qui
+ *       le possèdent, puis la ligne de blocs k le long des colonnes de la
+ *       grille et la colonne de blocs k le long des lignes.
  * @note Chaque processus MPI utilise num_threads threads OpenMP
  * @note Configuration optimale : p × t ≈ nombre de cœurs physiques
  */
-int* floydBlocsHybrid(int* D_local,
-                   int nb_nodes, int p_sqrt, int pid, int root, int num_threads);
+template<typename T>
+T* floydBlocsHybrid(T* D_local, const Distribution& dist, int root,
+                      int num_threads, bool anticipation = false, int* N_local = nullptr,
+                      PointReprise* reprise = nullptr, TempsPhases* temps = nullptr);
+
+/**
+ * @brief Floyd-Warshall par blocs hors mémoire : état et statistiques
+ *
+ * Les blocs locaux de chaque processus vivent dans une région du fichier
+ * partagé (régions à la suite dans l'ordre des rangs, blocs (li, lj) rangés
+ * comme dans D_local) et passent par un cache de `memoire` octets.
+ */
+struct HorsMemoire {
+    const char* fichier;    /**< Fichier des blocs */
+    long long memoire;      /**< Octets de blocs en mémoire par processus */
+    StockTuiles stock;      /**< (sortie) Magasin ouvert, blocs finaux */
+    double temps_construction; /**< (sortie) Écriture des blocs initiaux */
+};
+
+/**
+ * @brief Floyd-Warshall par blocs quand n² poids dépassent la mémoire :
+ *        même distribution et mêmes diffusions que floydBlocsLocal, mais
+ *        les blocs locaux sont lus et écrits dans un fichier (StockTuiles)
+ *        et seuls memoire octets de blocs, le pivot et les panneaux K
+ *        restent en mémoire.
+ *
+ * Les blocs sont construits directement dans le fichier depuis les arêtes
+ * (réparties comme par distribuerAretes). À chaque étape K, les E/S suivent
+ * l'ordre des dépendances : bloc pivot, ligne et colonne de blocs K (qui
+ * forment les panneaux diffusés), puis les autres blocs par lots de la
+ * taille du cache, le lot suivant étant lu à l'avance pendant le calcul du
+ * lot courant. Les blocs de la ligne et de la colonne K+1 sont traités en
+ * dernier pour rester en cache au début de l'étape suivante.
+ *
+ * En sortie, hm->stock est ouvert sur les blocs finaux (tuile(hm->stock,
+ * li*dist.colonnes + lj, TUILE_LECTURE)) ; le fermer avec fermerStock.
+ *
+ * @param aretes Triplets (u, v, poids) (significatif sur root uniquement)
+ * @param nb_aretes Nombre de triplets (significatif sur root uniquement)
+ * @param dist Distribution bloc-cyclique
+ * @param root Processus racine
+ * @param num_threads Nombre de threads OpenMP (0 = automatique)
+ * @param hm Fichier, mémoire allouée et statistiques
+ * @return int 0 si succès, -1 si le fichier ne peut être ouvert
+ */
+template<typename T>
+int floydHorsMemoire(const int* aretes, long nb_aretes, const Distribution& dist, int root,
+                     int num_threads, HorsMemoire* hm);
+
+/**
+ * @brief Écrit la matrice résultat distribuée dans un fichier binaire
+ *        (collectif, MPI-IO), sans la rassembler sur le root
+ *
+ * Format : en-tête de 32 octets ("FLOYDRS1", sizeof(T) et T flottant en
+ * int32, n en int64, 8 octets réservés) puis les n x n valeurs de type T
+ * rangées par lignes. Chaque processus pose une vue de fichier décrivant
+ * ses blocs (MPI_Type_create_darray, bloc-cyclique) et les écrit avec
+ * MPI_File_write_all directement depuis D_local (entrées de complétion
+ * exclues).
+ *
+ * @param f Fichier (remplacé s'il existe)
+ * @param D_local Blocs locaux
+ * @param dist Distribution bloc-cyclique
+ * @return int 0 si succès, -1 sinon (sur tous les processus)
+ */
+template<typename T>
+int ecrireResultat(const char* f, const T* D_local, const Distribution& dist);
+
+/**
+ * @brief Même format que ecrireResultat, depuis les blocs finaux d'un
+ *        calcul hors mémoire (lus bloc par bloc dans hm->stock)
+ */
+template<typename T>
+int ecrireResultatHorsMemoire(const char* f, HorsMemoire* hm, const Distribution& dist);
+
+/**
+ * @brief Même format que ecrireResultat (distances int), depuis des lignes
+ *        consécutives par processus (moteur creux)
+ *
+ * @param lignes nb_lignes lignes de n distances, à partir de la ligne premiere
+ * @param comm Communicateur de tous les processus
+ */
+int ecrireResultatLignes(const char* f, const int* lignes, int premiere, int nb_lignes,
+                         int n, MPI_Comm comm);
+
+/**
+ * @brief Prépare des blocs de distances initiales (D^(-1)) pour les chemins
+ *        de goulot MaxMin<T> : les paires sans arête passent à 0, la
+ *        diagonale à l'infini, les poids d'arêtes deviennent des largeurs
+ *        (tri : blocs du mode symétrique)
+ */
+template<typename T>
+void largeursDepuisDistances(T* D_local, const Distribution& dist, const Triangle* tri = nullptr);
+
+/**
+ * @brief Nombre de mots du tableau local compacté de Accessibilite
+ */
+long tailleCompacte(const Distribution& dist);
+
+/**
+ * @brief Compacte les blocs locaux de distances en blocs d'accessibilité
+ *        (bit (i, j) levé si D[i][j] < infini), même distribution
+ * 
+ * @return uint64_t* tailleCompacte(dist) mots, à libérer avec delete[]
+ */
+template<typename T>
+uint64_t* compacterAccessibilite(const T* D_local, const Distribution& dist);
+
+/**
+ * @brief Déplie les blocs compactés en entiers 0/1 rangés comme D_local,
+ *        que rassemblerMatrice peut ensuite rassembler
+ * 
+ * @param A_local Sortie, tailleLocale(dist) entiers
+ */
+void deplierAccessibilite(const uint64_t* R_local, const Distribution& dist, int* A_local);
+
+/**
+ * @brief Initialise les successeurs locaux à partir des blocs initiaux
+ *        (équivalent distribué de InitNext) : N[i][j] = j s'il existe une
+ *        arête i -> j, -1 sinon
+ * 
+ * @param D_local Blocs locaux de D^(-1)
+ * @param N_local Successeurs locaux (sortie, tailleLocale(dist) entiers)
+ * @param dist Distribution bloc-cyclique
+ */
+template<typename T>
+void initialiserSuivants(const T* D_local, int* N_local, const Distribution& dist);
+
+/**
+ * @brief Mise à jour incrémentale après l'ajout de l'arête u -> v de poids w
+ *        (ou la baisse de son poids) sur des blocs déjà fermés :
+ *        D[i][j] = min(D[i][j], D[i][u] + w + D[v][j]) en O(n² / P).
+ *        Opération collective ; seuls la colonne u et la ligne v circulent
+ *        (MPI_Bcast sur les lignes et colonnes de la grille).
+ *
+ * @param D_local Blocs locaux de la matrice de distances finale, mis à jour
+ * @param dist Distribution bloc-cyclique
+ * @param u Origine de l'arête
+ * @param v Destination de l'arête
+ * @param w Nouveau poids (sans effet s'il n'améliore pas D[u][v])
+ * @param N_local Successeurs mis à jour en même temps (nullptr si inutile)
+ */
+template<typename T>
+void insererArete(T* D_local, const Distribution& dist, int u, int v, T w, int* N_local = nullptr);
+
+/**
+ * @brief Insère un lot d'arêtes (u, v, poids), identique sur tous les
+ *        processus, une par une avec insererArete
+ */
+template<typename T>
+void insererAretes(T* D_local, const Distribution& dist, const int* aretes, long nb_aretes,
+                   int* N_local = nullptr);
+
+/**
+ * @brief Ajoute un sommet x = dist->n à des blocs déjà fermés, avec ses
+ *        arêtes (opération collective).
+ *
+ * Le sommet occupe la première ligne/colonne de complétion ; si le dernier
+ * bloc est plein, les tableaux locaux sont réalloués avec un bloc-ligne et
+ * un bloc-colonne de plus (la grille ne change pas). Ses arêtes sont
+ * ensuite insérées avec insererArete, soit O(degré · n² / P).
+ *
+ * @param D_local Blocs locaux (peut être réalloué)
+ * @param dist Distribution, n (et éventuellement nblocs) mis à jour
+ * @param aretes Arêtes (u, v, poids) dont une extrémité est x, identiques
+ *        sur tous les processus
+ * @param N_local Successeurs (peut être réalloué ; nullptr si inutile)
+ * @return int Indice du nouveau sommet
+ */
+template<typename T>
+int ajouterSommet(T** D_local, Distribution* dist, const int* aretes, long nb_aretes,
+                  int** N_local = nullptr);
+
+/**
+ * @brief Plus court chemin de i à j à partir des successeurs distribués
+ *        (opération collective : un MPI_Bcast par sommet du chemin, depuis
+ *        le propriétaire de l'entrée (u, j))
+ * 
+ * @return vector<int> Sommets du chemin, i et j compris (vide si aucun chemin)
+ */
+vector<int> cheminDistribue(const int* N_local, const Distribution& dist, int i, int j);
 
 #endif
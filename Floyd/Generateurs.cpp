@@ -0,0 +1,138 @@
+#include "Generateurs.hpp"
+
+#include <omp.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+static const char* NOMS_FAMILLES[] = {"aleatoire", "grille", "geometrique", "epsilon"};
+
+const char* nomFamille(FamilleGraphe f) {
+    return NOMS_FAMILLES[f];
+}
+
+bool familleDepuisNom(const string& nom, FamilleGraphe* f) {
+    for (int x = 0; x < 4; x++)
+        if (nom == NOMS_FAMILLES[x]) {
+            *f = (FamilleGraphe)x;
+            return true;
+        }
+    return false;
+}
+
+static void ajouter(vector<int>& aretes, int u, int v, int w) {
+    aretes.push_back(u);
+    aretes.push_back(v);
+    aretes.push_back(w);
+}
+
+static vector<int> aretesAleatoires(int n, int degre, int poids_max, mt19937& g) {
+    uniform_int_distribution<int> sommet(0, n - 1), poids(1, poids_max);
+    long m = (long)n * degre / 2;
+    vector<int> aretes;
+    aretes.reserve(3 * m);
+    while ((long)aretes.size() < 3 * m && n > 1) {
+        int u = sommet(g), v = sommet(g);
+        if (u != v) ajouter(aretes, u, v, poids(g));
+    }
+    return aretes;
+}
+
+static vector<int> aretesGrille(int n, int poids_max, mt19937& g) {
+    uniform_int_distribution<int> poids(1, poids_max);
+    int cote = (int)ceil(sqrt((double)n));
+    vector<int> aretes;
+    for (int i = 0; i < n; i++) {
+        if (i % cote + 1 < cote && i + 1 < n) ajouter(aretes, i, i + 1, poids(g));
+        if (i + cote < n) ajouter(aretes, i, i + cote, poids(g));
+    }
+    return aretes;
+}
+
+/* Points rangés dans des cases de côté >= r : seules les 9 cases voisines
+ * sont examinées */
+static vector<int> aretesGeometriques(int n, int degre, int poids_max, mt19937& g) {
+    uniform_real_distribution<double> coord(0.0, 1.0);
+    double r = sqrt(degre / (M_PI * n));
+    int cases = max(1, (int)(1.0 / r));
+    vector<double> x(n), y(n);
+    vector<vector<int> > contenu((long)cases * cases);
+    for (int i = 0; i < n; i++) {
+        x[i] = coord(g);
+        y[i] = coord(g);
+        int cx = min(cases - 1, (int)(x[i] * cases)), cy = min(cases - 1, (int)(y[i] * cases));
+        contenu[(long)cy * cases + cx].push_back(i);
+    }
+    vector<int> aretes;
+    for (int i = 0; i < n; i++) {
+        int cx = min(cases - 1, (int)(x[i] * cases)), cy = min(cases - 1, (int)(y[i] * cases));
+        for (int dy = -1; dy <= 1; dy++)
+            for (int dx = -1; dx <= 1; dx++) {
+                int ax = cx + dx, ay = cy + dy;
+                if (ax < 0 || ay < 0 || ax >= cases || ay >= cases) continue;
+                for (int j : contenu[(long)ay * cases + ax]) {
+                    if (j <= i) continue;
+                    double d = hypot(x[i] - x[j], y[i] - y[j]);
+                    if (d < r) ajouter(aretes, i, j, 1 + (int)((poids_max - 1) * d / r));
+                }
+            }
+    }
+    return aretes;
+}
+
+/* Séquences de 32 lettres codées sur 2 bits : une lettre diffère si l'un de
+ * ses deux bits diffère */
+static int hamming(uint64_t a, uint64_t b) {
+    uint64_t x = a ^ b;
+    return __builtin_popcountll((x | (x >> 1)) & 0x5555555555555555ULL);
+}
+
+static vector<int> aretesEpsilon(int n, int epsilon, mt19937& g) {
+    const int longueur = 32, famille = 64;
+    const double mutation = 0.15;
+    uniform_int_distribution<int> lettre(0, 3);
+    uniform_real_distribution<double> tirage(0.0, 1.0);
+    int nb_ancetres = max(1, n / famille);
+    vector<uint64_t> ancetres(nb_ancetres), seq(n);
+    for (uint64_t& a : ancetres)
+        for (int p = 0; p < longueur; p++) a |= (uint64_t)lettre(g) << (2*p);
+    for (int i = 0; i < n; i++) {
+        uint64_t s = ancetres[g() % nb_ancetres];
+        for (int p = 0; p < longueur; p++)
+            if (tirage(g) < mutation)
+                s = (s & ~(3ULL << (2*p))) | ((uint64_t)lettre(g) << (2*p));
+        seq[i] = s;
+    }
+
+    // Toutes les paires, comme ARNSequence ; lignes rangées dans l'ordre de i
+    vector<vector<int> > lignes(n);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < n; i++)
+        for (int j = i + 1; j < n; j++) {
+            int d = hamming(seq[i], seq[j]);
+            if (d <= epsilon) {
+                lignes[i].push_back(j);
+                lignes[i].push_back(max(1, d));
+            }
+        }
+    vector<int> aretes;
+    for (int i = 0; i < n; i++) {
+        for (size_t x = 0; x < lignes[i].size(); x += 2)
+            ajouter(aretes, i, lignes[i][x], lignes[i][x+1]);
+        vector<int>().swap(lignes[i]);
+    }
+    return aretes;
+}
+
+vector<int> genererGraphe(FamilleGraphe f, int n, int degre, int poids_max, unsigned graine) {
+    mt19937 g(graine);
+    switch (f) {
+        case GRAPHE_GRILLE:      return aretesGrille(n, poids_max, g);
+        case GRAPHE_GEOMETRIQUE: return aretesGeometriques(n, degre, poids_max, g);
+        case GRAPHE_EPSILON:     return aretesEpsilon(n, degre, g);
+        default:                 return aretesAleatoires(n, degre, poids_max, g);
+    }
+}
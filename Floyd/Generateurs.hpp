@@ -0,0 +1,50 @@
+#ifndef GENERATEURS_HPP
+#define GENERATEURS_HPP
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Graphes synthétiques non orientés, générés en mémoire sous forme
+ *        de triplets (u, v, poids) comme ceux de lectureAretes (poids >= 1).
+ *        Le même (n, degre, graine) donne toujours le même graphe.
+ *
+ *  - GRAPHE_ALEATOIRE  : n*degre/2 arêtes tirées uniformément (Erdős–Rényi) ;
+ *  - GRAPHE_GRILLE     : grille 2D de côté ceil(sqrt(n)), 4 voisins ;
+ *  - GRAPHE_GEOMETRIQUE: points du carré unité reliés à distance < r, r
+ *                        choisi pour un degré moyen ~ degre, poids
+ *                        proportionnel à la distance ;
+ *  - GRAPHE_EPSILON    : séquences de 32 lettres ACGU dérivées de quelques
+ *                        ancêtres par mutations, reliées si leur distance de
+ *                        Hamming est <= degre (seuil epsilon, comme le graphe
+ *                        de ARNSequence), poids = distance.
+ */
+enum FamilleGraphe { GRAPHE_ALEATOIRE, GRAPHE_GRILLE, GRAPHE_GEOMETRIQUE, GRAPHE_EPSILON };
+
+/**
+ * @brief Nom d'une famille ("aleatoire", "grille", "geometrique", "epsilon")
+ */
+const char* nomFamille(FamilleGraphe f);
+
+/**
+ * @brief Famille d'après son nom
+ * @return bool faux si le nom est inconnu
+ */
+bool familleDepuisNom(const string& nom, FamilleGraphe* f);
+
+/**
+ * @brief Génère un graphe de la famille f
+ *
+ * @param f Famille
+ * @param n Nombre de sommets
+ * @param degre Degré moyen visé (seuil de Hamming pour GRAPHE_EPSILON ;
+ *        ignoré par GRAPHE_GRILLE)
+ * @param poids_max Poids maximal des arêtes
+ * @param graine Graine du générateur pseudo-aléatoire
+ * @return vector<int> Triplets (u, v, poids)
+ */
+vector<int> genererGraphe(FamilleGraphe f, int n, int degre, int poids_max, unsigned graine);
+
+#endif
@@ -0,0 +1,134 @@
+#include "GrapheBinaire.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+static inline size_t aligner8(size_t x) {
+    return (x + 7) & ~(size_t)7;
+}
+
+bool estFichierCSR(const char* f) {
+    char magie[8];
+    FILE* fp = fopen(f, "rb");
+    if (!fp) return false;
+    bool ok = fread(magie, 1, 8, fp) == 8 && memcmp(magie, CSR_MAGIE, 8) == 0;
+    fclose(fp);
+    return ok;
+}
+
+int ouvrirCSR(const char* f, VueCSR* vue) {
+    int fd = open(f, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(EnteteCSR)) {
+        close(fd);
+        return -1;
+    }
+    void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return -1;
+
+    const EnteteCSR* e = (const EnteteCSR*)base;
+    const char* p = (const char*)base;
+    size_t o_debut = aligner8(sizeof(EnteteCSR));
+    size_t o_voisins = o_debut + 8*(size_t)(e->n + 1);
+    size_t o_poids = aligner8(o_voisins + 4*(size_t)e->m);
+    size_t o_noms_debut = aligner8(o_poids + 4*(size_t)e->m);
+    size_t o_noms = o_noms_debut + 8*(size_t)(e->n + 1);
+    bool valide = memcmp(e->magie, CSR_MAGIE, 8) == 0 && e->version == CSR_VERSION
+                  && e->n >= 0 && e->n < INT32_MAX && e->m >= 0 && e->m <= st.st_size
+                  && e->taille_noms >= 0 && e->taille_noms <= st.st_size
+                  && o_noms + (size_t)e->taille_noms <= (size_t)st.st_size;
+    if (valide) {
+        const int64_t* debut = (const int64_t*)(p + o_debut);
+        valide = debut[0] == 0 && debut[e->n] == e->m;
+    }
+    if (valide) {
+        // Fichier corrompu ou tronqué : les lecteurs indexent sans contrôle,
+        // donc debut croissant, voisins dans [0, n) et noms terminés par '\0'
+        const int64_t* debut = (const int64_t*)(p + o_debut);
+        const int32_t* voisins = (const int32_t*)(p + o_voisins);
+        const int64_t* noms_debut = (const int64_t*)(p + o_noms_debut);
+        const char* noms = p + o_noms;
+        long n = (long)e->n, m = (long)e->m, taille_noms = (long)e->taille_noms;
+        valide = n == 0 || (taille_noms > 0 && noms[taille_noms - 1] == '\0');
+        #pragma omp parallel for reduction(&&:valide)
+        for (long u = 0; u < n; u++)
+            valide = valide && debut[u] <= debut[u+1]
+                     && noms_debut[u] >= 0 && noms_debut[u] < taille_noms;
+        #pragma omp parallel for reduction(&&:valide)
+        for (long a = 0; a < m; a++)
+            valide = valide && voisins[a] >= 0 && voisins[a] < n;
+    }
+    if (!valide) {
+        munmap(base, st.st_size);
+        return -1;
+    }
+
+    vue->n = (int)e->n;
+    vue->m = (long)e->m;
+    vue->non_oriente = (e->drapeaux & CSR_NON_ORIENTE) != 0;
+    vue->debut = (const int64_t*)(p + o_debut);
+    vue->voisins = (const int32_t*)(p + o_voisins);
+    vue->poids = (const int32_t*)(p + o_poids);
+    vue->noms_debut = (const int64_t*)(p + o_noms_debut);
+    vue->noms = p + o_noms;
+    vue->base = base;
+    vue->taille = st.st_size;
+    // Les sections sont parcourues de bout en bout par les lecteurs
+    madvise(base, st.st_size, MADV_WILLNEED);
+    return 0;
+}
+
+void fermerCSR(VueCSR& vue) {
+    if (vue.base) munmap(vue.base, vue.taille);
+    vue.base = nullptr;
+}
+
+/* Écrit len octets puis complète par des zéros jusqu'au multiple de 8 */
+static bool ecrireSection(FILE* fp, const void* data, size_t len) {
+    static const char zeros[8] = {0};
+    if (len && fwrite(data, 1, len, fp) != len) return false;
+    size_t pad = aligner8(len) - len;
+    return pad == 0 || fwrite(zeros, 1, pad, fp) == pad;
+}
+
+int ecrireCSR(const char* f, int n, const long* debut, const int* voisins, const int* poids,
+              const vector<string>& noms, bool non_oriente) {
+    long m = debut[n];
+    vector<int64_t> d(debut, debut + n + 1);
+    vector<int64_t> noms_debut(n + 1, 0);
+    string texte;
+    for (int u = 0; u < n; u++) {
+        noms_debut[u] = (int64_t)texte.size();
+        texte += noms.empty() ? to_string(u) : noms[u];
+        texte += '\0';
+    }
+    noms_debut[n] = (int64_t)texte.size();
+
+    EnteteCSR e;
+    memset(&e, 0, sizeof(e));
+    memcpy(e.magie, CSR_MAGIE, 8);
+    e.version = CSR_VERSION;
+    e.drapeaux = non_oriente ? CSR_NON_ORIENTE : 0;
+    e.n = n;
+    e.m = m;
+    e.taille_noms = (int64_t)texte.size();
+
+    FILE* fp = fopen(f, "wb");
+    if (!fp) return -1;
+    bool ok = ecrireSection(fp, &e, sizeof(e))
+              && ecrireSection(fp, d.data(), 8*(size_t)(n + 1))
+              && ecrireSection(fp, voisins, 4*(size_t)m)
+              && ecrireSection(fp, poids, 4*(size_t)m)
+              && ecrireSection(fp, noms_debut.data(), 8*(size_t)(n + 1))
+              && ecrireSection(fp, texte.data(), texte.size());
+    ok = (fclose(fp) == 0) && ok;
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,100 @@
+#ifndef GRAPHEBINAIRE_HPP
+#define GRAPHEBINAIRE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Format binaire de graphe (.gcsr), lu par projection mémoire.
+ *
+ * Fichier little-endian, sections alignées sur 8 octets :
+ *  - en-tête EnteteCSR (64 octets) ;
+ *  - debut      : n+1 int64, les arcs de u sont [debut[u], debut[u+1]) ;
+ *  - voisins    : m int32 ;
+ *  - poids      : m int32 ;
+ *  - noms_debut : n+1 int64, décalages dans noms ;
+ *  - noms       : noms des sommets à la suite, chacun terminé par '\0'.
+ *
+ * Un graphe non orienté (drapeau CSR_NON_ORIENTE) contient ses deux arcs
+ * u -> v et v -> u : les voisins se lisent directement, sans symétrisation.
+ */
+#define CSR_MAGIE "GRAPHCSR"
+#define CSR_VERSION 1
+#define CSR_NON_ORIENTE 1u
+
+struct EnteteCSR {
+    char magie[8];          /**< "GRAPHCSR" */
+    uint32_t version;       /**< CSR_VERSION */
+    uint32_t drapeaux;      /**< CSR_NON_ORIENTE */
+    int64_t n;              /**< Nombre de sommets */
+    int64_t m;              /**< Nombre d'arcs (entrées de voisins) */
+    int64_t taille_noms;    /**< Octets de la section noms */
+    int64_t reserve[3];
+};
+
+/**
+ * @brief Vue sans copie d'un fichier .gcsr : les tableaux pointent dans la
+ *        projection mémoire et restent valides jusqu'à fermerCSR
+ */
+struct VueCSR {
+    int n;                      /**< Nombre de sommets */
+    long m;                     /**< Nombre d'arcs */
+    bool non_oriente;           /**< Arcs présents dans les deux sens */
+    const int64_t* debut;       /**< n+1 débuts de liste */
+    const int32_t* voisins;     /**< m voisins */
+    const int32_t* poids;       /**< m poids */
+    const int64_t* noms_debut;  /**< n+1 décalages des noms */
+    const char* noms;           /**< Noms terminés par '\0' */
+    void* base;                 /**< Projection (munmap) */
+    size_t taille;              /**< Taille de la projection */
+};
+
+/**
+ * @brief Vrai si le fichier commence par l'en-tête .gcsr
+ */
+bool estFichierCSR(const char* f);
+
+/**
+ * @brief Projette un fichier .gcsr en mémoire (mmap) et vérifie son en-tête,
+ *        la taille de ses sections et leur contenu : debut croissant,
+ *        voisins dans [0, n), décalages des noms dans la section et noms
+ *        terminés par '\0' (un parcours O(n + m))
+ *
+ * @param f Fichier à ouvrir
+ * @param vue Vue sur le graphe (sortie), à libérer avec fermerCSR
+ * @return int 0 si succès, -1 en cas d'erreur
+ */
+int ouvrirCSR(const char* f, VueCSR* vue);
+
+/**
+ * @brief Libère la projection d'une vue ouverte par ouvrirCSR
+ */
+void fermerCSR(VueCSR& vue);
+
+/**
+ * @brief Nom du sommet u d'une vue
+ */
+inline const char* nomSommet(const VueCSR& vue, int u) {
+    return vue.noms + vue.noms_debut[u];
+}
+
+/**
+ * @brief Écrit un graphe au format .gcsr
+ *
+ * @param f Fichier de sortie
+ * @param n Nombre de sommets
+ * @param debut n+1 débuts de liste
+ * @param voisins debut[n] voisins
+ * @param poids debut[n] poids
+ * @param noms Noms des sommets (vide : "0", "1", ...)
+ * @param non_oriente Les arcs sont présents dans les deux sens
+ * @return int 0 si succès, -1 en cas d'erreur
+ */
+int ecrireCSR(const char* f, int n, const long* debut, const int* voisins, const int* poids,
+              const vector<string>& noms, bool non_oriente = true);
+
+#endif
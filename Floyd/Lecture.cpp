@@ -0,0 +1,447 @@
+#include "Lecture.hpp"
+#include "GrapheBinaire.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+/* Taille minimale d'un morceau analysé par un thread */
+#define LECTURE_MORCEAU (1 << 18)
+
+/* Poids d'une arête sans attribut weight, remplacé par le poids par défaut
+ * (edge [weight=...]) une fois tous les morceaux lus */
+#define POIDS_ABSENT INT_MIN
+
+/* Nom de sommet : octets du fichier projeté, sans les guillemets */
+struct Nom {
+    const char* p;
+    int len;
+};
+
+static inline uint64_t hacherNom(const char* p, int len) {
+    uint64_t h = 1469598103934665603ULL;   // FNV-1a
+    for (int i = 0; i < len; i++) {
+        h ^= (unsigned char)p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/* Table nom -> numéro à adressage ouvert (sondage linéaire, capacité
+ * puissance de 2, taux de remplissage <= 1/2). Les numéros sont donnés
+ * dans l'ordre de première insertion. */
+struct TableNoms {
+    vector<int> cases;          // -1 = case vide, sinon numéro du nom
+    vector<Nom> noms;           // noms par numéro
+    vector<uint64_t> empreintes; // hachés par numéro (réhachage sans relecture)
+
+    TableNoms() : cases(1024, -1) {}
+
+    int numero(const char* p, int len) {
+        uint64_t h = hacherNom(p, len);
+        size_t masque = cases.size() - 1;
+        for (size_t c = h & masque; ; c = (c + 1) & masque) {
+            int x = cases[c];
+            if (x < 0) {
+                x = (int)noms.size();
+                noms.push_back({p, len});
+                empreintes.push_back(h);
+                cases[c] = x;
+                if (2*noms.size() > cases.size()) agrandir();
+                return x;
+            }
+            if (empreintes[x] == h && noms[x].len == len && memcmp(noms[x].p, p, len) == 0)
+                return x;
+        }
+    }
+
+    void agrandir() {
+        vector<int>(2*cases.size(), -1).swap(cases);
+        size_t masque = cases.size() - 1;
+        for (int x = 0; x < (int)noms.size(); x++) {
+            size_t c = empreintes[x] & masque;
+            while (cases[c] >= 0) c = (c + 1) & masque;
+            cases[c] = x;
+        }
+    }
+};
+
+/* Résultat de l'analyse d'un morceau [debut, fin) du fichier */
+struct Morceau {
+    TableNoms noms;             // numéros locaux au morceau
+    vector<int> aretes;         // (u, v, poids) en numéros locaux
+    int poids_defaut;           // dernier edge [weight=...] vu (POIDS_ABSENT sinon)
+    bool suite;                 // commence au milieu d'une instruction
+    bool ouvert;                // finit dans une chaîne, un commentaire, [ ] ou après --
+    bool fin_graphe;            // '}' final rencontré
+    bool erreur;                // construction hors du format reconnu
+
+    Morceau() : poids_defaut(POIDS_ABSENT), suite(false), ouvert(false),
+                fin_graphe(false), erreur(false) {}
+};
+
+enum Jeton { J_FIN, J_ID, J_ARETE, J_CROCHET_O, J_CROCHET_F, J_EGAL,
+             J_SEPARATEUR, J_ACCOLADE_O, J_ACCOLADE_F, J_AUTRE };
+
+static inline bool caractereId(unsigned char c) {
+    return isalnum(c) || c == '_' || c == '.' || c >= 0x80;
+}
+
+/* Jeton DOT suivant ; *ouvert est levé si fin tombe dans une chaîne ou un
+ * commentaire. Les noms entre guillemets sont rendus sans les guillemets
+ * (*guillemets levé) ; un échappement donne J_AUTRE. */
+static Jeton jetonDot(const char*& p, const char* fin, Nom* id, bool* guillemets, bool* ouvert) {
+    for (;;) {
+        while (p < fin && isspace((unsigned char)*p)) p++;
+        if (p >= fin) return J_FIN;
+        if (*p == '#' || (*p == '/' && p+1 < fin && p[1] == '/')) {
+            while (p < fin && *p != '\n') p++;
+            continue;
+        }
+        if (*p == '/' && p+1 < fin && p[1] == '*') {
+            const char* q = p + 2;
+            while (q+1 < fin && !(q[0] == '*' && q[1] == '/')) q++;
+            if (q+1 >= fin) { p = fin; *ouvert = true; return J_FIN; }
+            p = q + 2;
+            continue;
+        }
+        break;
+    }
+    char c = *p;
+    *guillemets = false;
+    if (c == '"') {
+        const char* q = ++p;
+        while (q < fin && *q != '"' && *q != '\\') q++;
+        if (q >= fin) { p = fin; *ouvert = true; return J_FIN; }
+        if (*q == '\\') { p = q; return J_AUTRE; }
+        id->p = p;
+        id->len = (int)(q - p);
+        *guillemets = true;
+        p = q + 1;
+        return J_ID;
+    }
+    if (c == '-' && p+1 < fin && (p[1] == '-' || p[1] == '>')) { p += 2; return J_ARETE; }
+    if (caractereId(c) || (c == '-' && p+1 < fin && (isdigit((unsigned char)p[1]) || p[1] == '.'))) {
+        const char* q = p + 1;
+        while (q < fin && caractereId(*q)) q++;
+        id->p = p;
+        id->len = (int)(q - p);
+        p = q;
+        return J_ID;
+    }
+    p++;
+    switch (c) {
+        case '[': return J_CROCHET_O;
+        case ']': return J_CROCHET_F;
+        case '=': return J_EGAL;
+        case ',': case ';': return J_SEPARATEUR;
+        case '{': return J_ACCOLADE_O;
+        case '}': return J_ACCOLADE_F;
+        default:  return J_AUTRE;
+    }
+}
+
+static inline bool motCle(const Nom& id, bool guillemets, const char* mot) {
+    int len = (int)strlen(mot);
+    if (guillemets || id.len != len) return false;
+    for (int i = 0; i < len; i++)
+        if (tolower((unsigned char)id.p[i]) != mot[i]) return false;
+    return true;
+}
+
+/* Entier en tête d'une valeur d'attribut ("5", 5, -3, 5.0 -> 5) */
+static bool lireEntier(const Nom& v, int* x) {
+    int i = 0;
+    bool negatif = (v.len > 0 && v.p[0] == '-');
+    if (negatif || (v.len > 0 && v.p[0] == '+')) i++;
+    if (i >= v.len || !isdigit((unsigned char)v.p[i])) return false;
+    long r = 0;
+    for (; i < v.len && isdigit((unsigned char)v.p[i]); i++)
+        r = min(10*r + (v.p[i] - '0'), (long)INT_MAX);
+    *x = (int)(negatif ? -r : r);
+    return true;
+}
+
+/* Liste d'attributs après '[' : rend le poids (POIDS_ABSENT si aucun) */
+static int lireAttributs(const char*& p, const char* fin, Morceau& m) {
+    int poids = POIDS_ABSENT;
+    Nom cle, valeur;
+    bool g;
+    for (;;) {
+        Jeton t = jetonDot(p, fin, &cle, &g, &m.ouvert);
+        if (t == J_CROCHET_F) return poids;
+        if (t == J_SEPARATEUR) continue;
+        if (t != J_ID) {
+            if (t == J_FIN) m.ouvert = true;
+            else m.erreur = true;
+            return poids;
+        }
+        const char* q = p;
+        bool gc = g;
+        if (jetonDot(q, fin, &valeur, &g, &m.ouvert) != J_EGAL) continue; // attribut sans valeur
+        p = q;
+        if (jetonDot(p, fin, &valeur, &g, &m.ouvert) != J_ID) {
+            if (m.ouvert) return poids;
+            m.erreur = true;
+            return poids;
+        }
+        if (motCle(cle, gc, "weight") && !lireEntier(valeur, &poids))
+            m.erreur = true;
+    }
+}
+
+/* Ajoute les arêtes d'une chaîne A -- B -- C */
+static void emettreChaine(const vector<int>& chaine, int poids, Morceau& m) {
+    for (size_t a = 1; a < chaine.size(); a++) {
+        m.aretes.push_back(chaine[a-1]);
+        m.aretes.push_back(chaine[a]);
+        m.aretes.push_back(poids);
+    }
+}
+
+/* Analyse les instructions DOT de [debut, fin) (corps du graphe) */
+static void analyserDot(const char* debut, const char* fin, Morceau& m) {
+    const char* p = debut;
+    vector<int> chaine;
+    Nom id;
+    bool g, premier = true;
+    for (;;) {
+        Jeton t = jetonDot(p, fin, &id, &g, &m.ouvert);
+        // Un morceau qui commence par --, [ ou = continue l'instruction du précédent
+        if (premier && (t == J_ARETE || t == J_CROCHET_O || t == J_EGAL || t == J_CROCHET_F))
+            m.suite = true;
+        premier = false;
+        if (t == J_FIN || m.suite) return;
+        if (t == J_SEPARATEUR) continue;
+        if (t == J_ACCOLADE_F) { m.fin_graphe = true; return; }
+        if (t != J_ID || motCle(id, g, "subgraph")) { m.erreur = true; return; }
+
+        // Instruction d'attributs par défaut : node, edge ou graph [ ... ]
+        if (motCle(id, g, "node") || motCle(id, g, "edge") || motCle(id, g, "graph")) {
+            bool arete = motCle(id, g, "edge");
+            Nom x;
+            if (jetonDot(p, fin, &x, &g, &m.ouvert) != J_CROCHET_O) {
+                if (!m.ouvert) m.erreur = true;
+                return;
+            }
+            int w = lireAttributs(p, fin, m);
+            if (arete && w != POIDS_ABSENT) m.poids_defaut = w;
+            continue;
+        }
+
+        // Affectation nom = valeur (attribut du graphe) ou sommet / chaîne d'arêtes
+        Nom premier_id = id;
+        const char* q = p;
+        t = jetonDot(q, fin, &id, &g, &m.ouvert);
+        if (t == J_EGAL) {
+            p = q;
+            if (jetonDot(p, fin, &id, &g, &m.ouvert) != J_ID && !m.ouvert) m.erreur = true;
+            if (m.ouvert || m.erreur) return;
+            continue;
+        }
+        chaine.assign(1, m.noms.numero(premier_id.p, premier_id.len));
+        int poids = POIDS_ABSENT;
+        for (;;) {
+            if (t == J_ARETE) {
+                p = q;
+                if (jetonDot(p, fin, &id, &g, &m.ouvert) != J_ID) {
+                    if (m.ouvert || p >= fin) m.ouvert = true;
+                    else m.erreur = true;
+                    return;
+                }
+                chaine.push_back(m.noms.numero(id.p, id.len));
+            } else if (t == J_CROCHET_O) {
+                p = q;
+                poids = lireAttributs(p, fin, m);
+                if (m.ouvert || m.erreur) return;
+            } else
+                break;  // jeton suivant relu par la boucle principale
+            q = p;
+            t = jetonDot(q, fin, &id, &g, &m.ouvert);
+        }
+        if (t == J_AUTRE) { m.erreur = true; return; }
+        emettreChaine(chaine, poids == POIDS_ABSENT ? m.poids_defaut : poids, m);
+    }
+}
+
+/* Analyse les lignes « u v [poids] » de [debut, fin) */
+static void analyserListe(const char* debut, const char* fin, Morceau& m) {
+    const char* p = debut;
+    while (p < fin) {
+        const char* eol = (const char*)memchr(p, '\n', fin - p);
+        if (!eol) eol = fin;
+        Nom champs[4];
+        int nc = 0;
+        while (p < eol && nc < 4) {
+            while (p < eol && (isspace((unsigned char)*p) || *p == ',')) p++;
+            if (p >= eol || *p == '#' || *p == '%' || (*p == '/' && p+1 < eol && p[1] == '/'))
+                break;
+            const char* q = p;
+            while (q < eol && !isspace((unsigned char)*q) && *q != ',') q++;
+            champs[nc++] = {p, (int)(q - p)};
+            p = q;
+        }
+        if (nc == 1 || nc == 4) { m.erreur = true; return; }
+        if (nc >= 2) {
+            int poids = 1;
+            if (nc == 3 && !lireEntier(champs[2], &poids)) { m.erreur = true; return; }
+            m.aretes.push_back(m.noms.numero(champs[0].p, champs[0].len));
+            m.aretes.push_back(m.noms.numero(champs[1].p, champs[1].len));
+            m.aretes.push_back(poids);
+        }
+        p = eol + 1;
+    }
+}
+
+/* En-tête DOT : [strict] graph|digraph [nom] { ; rend le début du corps,
+ * nullptr si le fichier n'est pas un DOT */
+static const char* enteteDot(const char* p, const char* fin) {
+    Nom id;
+    bool g, ouvert = false;
+    Jeton t = jetonDot(p, fin, &id, &g, &ouvert);
+    if (t == J_ID && motCle(id, g, "strict")) t = jetonDot(p, fin, &id, &g, &ouvert);
+    if (t != J_ID || !(motCle(id, g, "graph") || motCle(id, g, "digraph"))) return nullptr;
+    t = jetonDot(p, fin, &id, &g, &ouvert);
+    if (t == J_ID) t = jetonDot(p, fin, &id, &g, &ouvert);
+    return t == J_ACCOLADE_O ? p : nullptr;
+}
+
+/* Analyse [debut, fin) en nb morceaux coupés en début de ligne */
+static void analyser(const char* debut, const char* fin, bool dot, int nb,
+                     vector<Morceau>& morceaux) {
+    vector<const char*> bornes(nb + 1, fin);
+    bornes[0] = debut;
+    for (int c = 1; c < nb; c++) {
+        const char* b = max(bornes[c-1], debut + (fin - debut) / nb * c);
+        const char* eol = (const char*)memchr(b, '\n', fin - b);
+        bornes[c] = eol ? eol + 1 : fin;
+    }
+    morceaux.assign(nb, Morceau());
+    #pragma omp parallel for schedule(dynamic)
+    for (int c = 0; c < nb; c++) {
+        if (dot) analyserDot(bornes[c], bornes[c+1], morceaux[c]);
+        else analyserListe(bornes[c], bornes[c+1], morceaux[c]);
+    }
+}
+
+/* Arêtes d'un fichier .gcsr : chaque arête non orientée une seule fois (u < v) */
+static int lectureCSR(const char* f, int* nb_nodes, map<string, int>* my_nodes,
+                      vector<int>* aretes) {
+    VueCSR vue;
+    if (ouvrirCSR(f, &vue) != 0) return -1;
+    aretes->clear();
+    aretes->reserve(3*(vue.non_oriente ? vue.m/2 : vue.m));
+    for (int u = 0; u < vue.n; u++)
+        for (int64_t a = vue.debut[u]; a < vue.debut[u+1]; a++)
+            if (!vue.non_oriente || u < vue.voisins[a]) {
+                aretes->push_back(u);
+                aretes->push_back(vue.voisins[a]);
+                aretes->push_back(vue.poids[a]);
+            }
+    *nb_nodes = vue.n;
+    for (int u = 0; u < vue.n; u++)
+        (*my_nodes)[nomSommet(vue, u)] = u;
+    fermerCSR(vue);
+    return 0;
+}
+
+int lectureRapide(const char* f, int* nb_nodes, map<string, int>* my_nodes,
+                  vector<int>* aretes, int num_threads) {
+    if (estFichierCSR(f))
+        return lectureCSR(f, nb_nodes, my_nodes, aretes);
+    int fd = open(f, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return -1;
+    }
+    size_t taille = st.st_size;
+    char* texte = (char*)mmap(nullptr, taille, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (texte == MAP_FAILED) return -1;
+    madvise(texte, taille, MADV_WILLNEED);
+
+    const char* fin = texte + taille;
+    const char* corps = enteteDot(texte, fin);
+    bool dot = (corps != nullptr);
+    if (!dot) corps = texte;
+
+#ifdef _OPENMP
+    int threads = num_threads > 0 ? num_threads : omp_get_max_threads();
+#else
+    int threads = 1;
+    (void)num_threads;
+#endif
+    int nb = (int)min<long>(4L*threads, max<long>(1, (fin - corps) / LECTURE_MORCEAU));
+
+    vector<Morceau> morceaux;
+    analyser(corps, fin, dot, nb, morceaux);
+    // Une coupure tombée au milieu d'une instruction : relecture d'un seul tenant
+    bool coupure = false;
+    for (int c = 0; c < nb; c++) {
+        if (c > 0 && morceaux[c-1].fin_graphe) break;
+        coupure |= morceaux[c].erreur || morceaux[c].suite || (morceaux[c].ouvert && c+1 < nb)
+                   || (dot && c > 0 && morceaux[c].poids_defaut != POIDS_ABSENT);
+    }
+    if (coupure && nb > 1) {
+        nb = 1;
+        analyser(corps, fin, dot, nb, morceaux);
+    }
+    // Les morceaux après le '}' final sont ignorés
+    int utiles = nb;
+    bool valide = true;
+    for (int c = 0; c < utiles; c++) {
+        valide = valide && !morceaux[c].erreur && !morceaux[c].suite && !morceaux[c].ouvert;
+        if (morceaux[c].fin_graphe) utiles = c + 1;
+    }
+    if (dot) valide = valide && morceaux[utiles-1].fin_graphe;
+    if (!valide) {
+        munmap(texte, taille);
+        return -1;
+    }
+
+    // Numérotation globale dans l'ordre des morceaux (ordre du fichier)
+    TableNoms noms;
+    vector<vector<int> > globaux(utiles);
+    for (int c = 0; c < utiles; c++) {
+        const TableNoms& t = morceaux[c].noms;
+        globaux[c].resize(t.noms.size());
+        for (size_t x = 0; x < t.noms.size(); x++)
+            globaux[c][x] = noms.numero(t.noms[x].p, t.noms[x].len);
+    }
+    // Arêtes sans poids : celles du premier morceau précèdent tout edge [weight=...]
+    // (sinon le défaut est déjà appliqué), les suivantes prennent son dernier défaut
+    int defaut = morceaux[0].poids_defaut == POIDS_ABSENT ? 1 : morceaux[0].poids_defaut;
+
+    vector<long> debut_aretes(utiles + 1, 0);
+    for (int c = 0; c < utiles; c++)
+        debut_aretes[c+1] = debut_aretes[c] + (long)morceaux[c].aretes.size();
+    aretes->resize(debut_aretes[utiles]);
+    #pragma omp parallel for schedule(dynamic)
+    for (int c = 0; c < utiles; c++) {
+        const vector<int>& a = morceaux[c].aretes;
+        int* sortie = aretes->data() + debut_aretes[c];
+        for (size_t x = 0; x < a.size(); x += 3) {
+            sortie[x] = globaux[c][a[x]];
+            sortie[x+1] = globaux[c][a[x+1]];
+            sortie[x+2] = (a[x+2] != POIDS_ABSENT) ? a[x+2] : (c == 0 ? 1 : defaut);
+        }
+    }
+
+    *nb_nodes = (int)noms.noms.size();
+    for (int x = 0; x < *nb_nodes; x++)
+        (*my_nodes)[string(noms.noms[x].p, noms.noms[x].len)] = x;
+    munmap(texte, taille);
+    return 0;
+}
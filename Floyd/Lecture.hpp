@@ -0,0 +1,47 @@
+#ifndef LECTURE_HPP
+#define LECTURE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Lecteur natif de graphes, sans Graphviz : le fichier est projeté en
+ *        mémoire (mmap) puis découpé en morceaux analysés en parallèle
+ *        (OpenMP). Les noms de sommets sont résolus par une table de hachage
+ *        à adressage ouvert, une seule insertion dans my_nodes par sommet.
+ *
+ * Deux formats sont reconnus, détectés sur le premier mot du fichier :
+ *  - le sous-ensemble de DOT que nous produisons (writeGraphDOT, exemples) :
+ *    en-tête [strict] graph|digraph [nom] {, déclarations de sommets
+ *    « A [attributs] », arêtes « A -- B -- C [weight=5, ...] » (ou ->),
+ *    affectations « rankdir=LR », instructions « node|edge|graph [...] »,
+ *    commentaires // et blocs C ; un poids par défaut peut être donné par
+ *    « edge [weight=...] », sinon une arête sans poids vaut 1 ;
+ *  - une liste d'arêtes, une par ligne : « u v [poids] » (poids 1 par
+ *    défaut), lignes vides et commentaires #, % ou // ignorés.
+ *
+ * Les sous-graphes, ports et noms entre guillemets contenant des
+ * échappements ne sont pas reconnus : la lecture échoue et l'appelant peut
+ * se replier sur libcgraph (lectureGraphe compilé avec -DWITH_GRAPHVIZ).
+ *
+ * Les sommets sont numérotés dans leur ordre de première apparition, comme
+ * le fait libcgraph ; les arêtes sont rendues dans l'ordre du fichier.
+ *
+ * Un fichier binaire .gcsr (GrapheBinaire.hpp) est reconnu à son en-tête
+ * et lu directement depuis sa projection, sans analyse.
+ *
+ * @param f Fichier à lire
+ * @param nb_nodes Nombre de sommets (sortie)
+ * @param my_nodes Correspondance nom -> numéro des sommets (sortie)
+ * @param aretes Triplets (u, v, poids) à la suite (sortie)
+ * @param num_threads Threads d'analyse (0 = omp_get_max_threads())
+ * @return int 0 si la lecture a réussi, -1 sinon (fichier illisible ou hors
+ *         du format reconnu)
+ */
+int lectureRapide(const char* f, int* nb_nodes, map<string, int>* my_nodes,
+                  vector<int>* aretes, int num_threads = 0);
+
+#endif
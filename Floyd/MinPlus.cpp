@@ -0,0 +1,565 @@
+#include "MinPlus.hpp"
+
+#include <immintrin.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+/* Blocage pour les caches : un panneau de B (KC x nr) reste en L1,
+ * un bloc de A (MC x KC) en L2. */
+#define MINPLUS_KC 256
+#define MINPLUS_MC 96
+
+/**
+ * @brief Description d'un jeu de noyaux pour le type de poids T : taille du
+ *        micro-bloc en registres et fonctions associées.
+ */
+template<typename T>
+struct NoyauMinPlus {
+    const char* nom;
+    int mr, nr;
+    /* C (mr x nr, pas ldc) = min(C, Ap ⊗ Bp) sur kc pivots empaquetés */
+    void (*micro)(int kc, const T* Ap, const T* Bp, T* C, int ldc);
+    /* c[j] = min(c[j], a + b[j]) pour j < n ; c et b peuvent coïncider */
+    void (*ligne)(T* c, T a, const T* b, int n);
+    /* idem, et s[j] = sa là où c[j] diminue strictement (successeurs) */
+    void (*ligneSuivant)(T* c, int* s, T a, int sa, const T* b, int n);
+};
+
+/* ====================== Scalaire ====================== */
+
+template<typename T>
+static void microScalaire(int kc, const T* Ap, const T* Bp, T* C, int ldc) {
+    T acc[4][4];
+    for (int r=0; r<4; r++)
+        for (int s=0; s<4; s++)
+            acc[r][s] = C[r*ldc+s];
+    for (int p=0; p<kc; p++)
+        for (int r=0; r<4; r++)
+            for (int s=0; s<4; s++)
+                acc[r][s] = min(acc[r][s], Poids<T>::plus(Ap[p*4+r], Bp[p*4+s]));
+    for (int r=0; r<4; r++)
+        for (int s=0; s<4; s++)
+            C[r*ldc+s] = acc[r][s];
+}
+
+template<typename T>
+static void ligneScalaire(T* c, T a, const T* b, int n) {
+    for (int j=0; j<n; j++)
+        c[j] = min(c[j], Poids<T>::plus(a, b[j]));
+}
+
+template<typename T>
+static void ligneSuivantScalaire(T* c, int* s, T a, int sa, const T* b, int n) {
+    for (int j=0; j<n; j++) {
+        T v = Poids<T>::plus(a, b[j]);
+        if (v < c[j]) { c[j] = v; s[j] = sa; }
+    }
+}
+
+/* Opérations vectorielles d'un jeu d'instructions pour un type de poids :
+ * L poids par registre, chargement, rangement, diffusion, addition saturante
+ * (au sens de Poids.hpp) et minimum. Pour les poids de 32 bits, inferieur
+ * donne le masque a < b utilisé par les successeurs. */
+#define OPS_SSE4   __attribute__((target("sse4.1"), always_inline)) static inline
+#define OPS_AVX2   __attribute__((target("avx2"), always_inline)) static inline
+#define OPS_AVX512 __attribute__((target("avx512f,avx512bw"), always_inline)) static inline
+
+template<typename T> struct SSE4;
+template<typename T> struct AVX2;
+template<typename T> struct AVX512;
+
+/* ====================== SSE4.1 : 4 x 2L ====================== */
+
+template<> struct SSE4<int16_t> {
+    typedef __m128i R;
+    enum { L = 8 };
+    OPS_SSE4 R charger(const int16_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+    OPS_SSE4 void ranger(int16_t* p, R v) { _mm_storeu_si128((__m128i*)p, v); }
+    OPS_SSE4 R diffuser(int16_t a) { return _mm_set1_epi16(a); }
+    OPS_SSE4 R plus(R a, R b) { return _mm_adds_epi16(a, b); }
+    OPS_SSE4 R mini(R a, R b) { return _mm_min_epi16(a, b); }
+};
+
+template<> struct SSE4<int32_t> {
+    typedef __m128i R;
+    enum { L = 4 };
+    OPS_SSE4 R charger(const int32_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+    OPS_SSE4 void ranger(int32_t* p, R v) { _mm_storeu_si128((__m128i*)p, v); }
+    OPS_SSE4 R diffuser(int32_t a) { return _mm_set1_epi32(a); }
+    OPS_SSE4 R plus(R a, R b) { return _mm_add_epi32(a, b); }
+    OPS_SSE4 R mini(R a, R b) { return _mm_min_epi32(a, b); }
+    OPS_SSE4 __m128i inferieur(R a, R b) { return _mm_cmpgt_epi32(b, a); }
+};
+
+template<> struct SSE4<float> {
+    typedef __m128 R;
+    enum { L = 4 };
+    OPS_SSE4 R charger(const float* p) { return _mm_loadu_ps(p); }
+    OPS_SSE4 void ranger(float* p, R v) { _mm_storeu_ps(p, v); }
+    OPS_SSE4 R diffuser(float a) { return _mm_set1_ps(a); }
+    OPS_SSE4 R plus(R a, R b) { return _mm_add_ps(a, b); }
+    OPS_SSE4 R mini(R a, R b) { return _mm_min_ps(a, b); }
+    OPS_SSE4 __m128i inferieur(R a, R b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+};
+
+template<typename T>
+__attribute__((target("sse4.1")))
+static void microSSE4(int kc, const T* Ap, const T* Bp, T* C, int ldc) {
+    typedef SSE4<T> V;
+    const int L = V::L;
+    typename V::R acc[4][2];
+    for (int r=0; r<4; r++)
+        for (int s=0; s<2; s++)
+            acc[r][s] = V::charger(C + r*ldc + L*s);
+    for (int p=0; p<kc; p++) {
+        typename V::R b0 = V::charger(Bp + p*2*L);
+        typename V::R b1 = V::charger(Bp + p*2*L + L);
+        for (int r=0; r<4; r++) {
+            typename V::R a = V::diffuser(Ap[p*4+r]);
+            acc[r][0] = V::mini(acc[r][0], V::plus(a, b0));
+            acc[r][1] = V::mini(acc[r][1], V::plus(a, b1));
+        }
+    }
+    for (int r=0; r<4; r++)
+        for (int s=0; s<2; s++)
+            V::ranger(C + r*ldc + L*s, acc[r][s]);
+}
+
+template<typename T>
+__attribute__((target("sse4.1")))
+static void ligneSSE4(T* c, T a, const T* b, int n) {
+    typedef SSE4<T> V;
+    typename V::R va = V::diffuser(a);
+    int j = 0;
+    for (; j+V::L<=n; j+=V::L)
+        V::ranger(c+j, V::mini(V::charger(c+j), V::plus(va, V::charger(b+j))));
+    ligneScalaire(c+j, a, b+j, n-j);
+}
+
+template<typename T>
+__attribute__((target("sse4.1")))
+static void ligneSuivantSSE4(T* c, int* s, T a, int sa, const T* b, int n) {
+    typedef SSE4<T> V;
+    typename V::R va = V::diffuser(a);
+    __m128i vs = _mm_set1_epi32(sa);
+    int j = 0;
+    for (; j+V::L<=n; j+=V::L) {
+        typename V::R vc = V::charger(c+j);
+        typename V::R v = V::plus(va, V::charger(b+j));
+        __m128i m = V::inferieur(v, vc);
+        __m128i ss = _mm_loadu_si128((const __m128i*)(s+j));
+        V::ranger(c+j, V::mini(vc, v));
+        _mm_storeu_si128((__m128i*)(s+j), _mm_blendv_epi8(ss, vs, m));
+    }
+    ligneSuivantScalaire(c+j, s+j, a, sa, b+j, n-j);
+}
+
+/* ====================== AVX2 : 6 x 2L ====================== */
+
+template<> struct AVX2<int16_t> {
+    typedef __m256i R;
+    enum { L = 16 };
+    OPS_AVX2 R charger(const int16_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    OPS_AVX2 void ranger(int16_t* p, R v) { _mm256_storeu_si256((__m256i*)p, v); }
+    OPS_AVX2 R diffuser(int16_t a) { return _mm256_set1_epi16(a); }
+    OPS_AVX2 R plus(R a, R b) { return _mm256_adds_epi16(a, b); }
+    OPS_AVX2 R mini(R a, R b) { return _mm256_min_epi16(a, b); }
+};
+
+template<> struct AVX2<int32_t> {
+    typedef __m256i R;
+    enum { L = 8 };
+    OPS_AVX2 R charger(const int32_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    OPS_AVX2 void ranger(int32_t* p, R v) { _mm256_storeu_si256((__m256i*)p, v); }
+    OPS_AVX2 R diffuser(int32_t a) { return _mm256_set1_epi32(a); }
+    OPS_AVX2 R plus(R a, R b) { return _mm256_add_epi32(a, b); }
+    OPS_AVX2 R mini(R a, R b) { return _mm256_min_epi32(a, b); }
+    OPS_AVX2 __m256i inferieur(R a, R b) { return _mm256_cmpgt_epi32(b, a); }
+};
+
+/* Pas de min_epi64 avant AVX-512 : comparaison puis sélection */
+template<> struct AVX2<int64_t> {
+    typedef __m256i R;
+    enum { L = 4 };
+    OPS_AVX2 R charger(const int64_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    OPS_AVX2 void ranger(int64_t* p, R v) { _mm256_storeu_si256((__m256i*)p, v); }
+    OPS_AVX2 R diffuser(int64_t a) { return _mm256_set1_epi64x(a); }
+    OPS_AVX2 R plus(R a, R b) { return _mm256_add_epi64(a, b); }
+    OPS_AVX2 R mini(R a, R b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+};
+
+template<> struct AVX2<float> {
+    typedef __m256 R;
+    enum { L = 8 };
+    OPS_AVX2 R charger(const float* p) { return _mm256_loadu_ps(p); }
+    OPS_AVX2 void ranger(float* p, R v) { _mm256_storeu_ps(p, v); }
+    OPS_AVX2 R diffuser(float a) { return _mm256_set1_ps(a); }
+    OPS_AVX2 R plus(R a, R b) { return _mm256_add_ps(a, b); }
+    OPS_AVX2 R mini(R a, R b) { return _mm256_min_ps(a, b); }
+    OPS_AVX2 __m256i inferieur(R a, R b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+};
+
+template<typename T>
+__attribute__((target("avx2")))
+static void microAVX2(int kc, const T* Ap, const T* Bp, T* C, int ldc) {
+    typedef AVX2<T> V;
+    const int L = V::L;
+    typename V::R acc[6][2];
+    for (int r=0; r<6; r++)
+        for (int s=0; s<2; s++)
+            acc[r][s] = V::charger(C + r*ldc + L*s);
+    for (int p=0; p<kc; p++) {
+        typename V::R b0 = V::charger(Bp + p*2*L);
+        typename V::R b1 = V::charger(Bp + p*2*L + L);
+        for (int r=0; r<6; r++) {
+            typename V::R a = V::diffuser(Ap[p*6+r]);
+            acc[r][0] = V::mini(acc[r][0], V::plus(a, b0));
+            acc[r][1] = V::mini(acc[r][1], V::plus(a, b1));
+        }
+    }
+    for (int r=0; r<6; r++)
+        for (int s=0; s<2; s++)
+            V::ranger(C + r*ldc + L*s, acc[r][s]);
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+static void ligneAVX2(T* c, T a, const T* b, int n) {
+    typedef AVX2<T> V;
+    typename V::R va = V::diffuser(a);
+    int j = 0;
+    for (; j+V::L<=n; j+=V::L)
+        V::ranger(c+j, V::mini(V::charger(c+j), V::plus(va, V::charger(b+j))));
+    ligneScalaire(c+j, a, b+j, n-j);
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+static void ligneSuivantAVX2(T* c, int* s, T a, int sa, const T* b, int n) {
+    typedef AVX2<T> V;
+    typename V::R va = V::diffuser(a);
+    __m256i vs = _mm256_set1_epi32(sa);
+    int j = 0;
+    for (; j+V::L<=n; j+=V::L) {
+        typename V::R vc = V::charger(c+j);
+        typename V::R v = V::plus(va, V::charger(b+j));
+        __m256i m = V::inferieur(v, vc);
+        __m256i ss = _mm256_loadu_si256((const __m256i*)(s+j));
+        V::ranger(c+j, V::mini(vc, v));
+        _mm256_storeu_si256((__m256i*)(s+j), _mm256_blendv_epi8(ss, vs, m));
+    }
+    ligneSuivantScalaire(c+j, s+j, a, sa, b+j, n-j);
+}
+
+/* ====================== AVX-512 (F et BW) : 8 x 2L ====================== */
+
+/* Les opérations sur 16 bits demandent AVX-512BW, exigé avec AVX-512F pour
+ * ce niveau. Pour les poids de 32 bits, les fins de ligne passent par des
+ * masques. */
+template<> struct AVX512<int16_t> {
+    typedef __m512i R;
+    enum { L = 32 };
+    OPS_AVX512 R charger(const int16_t* p) { return _mm512_loadu_si512(p); }
+    OPS_AVX512 void ranger(int16_t* p, R v) { _mm512_storeu_si512(p, v); }
+    OPS_AVX512 R diffuser(int16_t a) { return _mm512_set1_epi16(a); }
+    OPS_AVX512 R plus(R a, R b) { return _mm512_adds_epi16(a, b); }
+    OPS_AVX512 R mini(R a, R b) { return _mm512_min_epi16(a, b); }
+};
+
+template<> struct AVX512<int32_t> {
+    typedef __m512i R;
+    enum { L = 16 };
+    OPS_AVX512 R charger(const int32_t* p) { return _mm512_loadu_si512(p); }
+    OPS_AVX512 void ranger(int32_t* p, R v) { _mm512_storeu_si512(p, v); }
+    OPS_AVX512 R diffuser(int32_t a) { return _mm512_set1_epi32(a); }
+    OPS_AVX512 R plus(R a, R b) { return _mm512_add_epi32(a, b); }
+    OPS_AVX512 R mini(R a, R b) { return _mm512_min_epi32(a, b); }
+    OPS_AVX512 R chargerMasque(__mmask16 k, const int32_t* p) { return _mm512_maskz_loadu_epi32(k, p); }
+    OPS_AVX512 void rangerMasque(int32_t* p, __mmask16 k, R v) { _mm512_mask_storeu_epi32(p, k, v); }
+    OPS_AVX512 __mmask16 inferieur(__mmask16 k, R a, R b) { return _mm512_mask_cmplt_epi32_mask(k, a, b); }
+};
+
+template<> struct AVX512<int64_t> {
+    typedef __m512i R;
+    enum { L = 8 };
+    OPS_AVX512 R charger(const int64_t* p) { return _mm512_loadu_si512(p); }
+    OPS_AVX512 void ranger(int64_t* p, R v) { _mm512_storeu_si512(p, v); }
+    OPS_AVX512 R diffuser(int64_t a) { return _mm512_set1_epi64(a); }
+    OPS_AVX512 R plus(R a, R b) { return _mm512_add_epi64(a, b); }
+    OPS_AVX512 R mini(R a, R b) { return _mm512_min_epi64(a, b); }
+};
+
+template<> struct AVX512<float> {
+    typedef __m512 R;
+    enum { L = 16 };
+    OPS_AVX512 R charger(const float* p) { return _mm512_loadu_ps(p); }
+    OPS_AVX512 void ranger(float* p, R v) { _mm512_storeu_ps(p, v); }
+    OPS_AVX512 R diffuser(float a) { return _mm512_set1_ps(a); }
+    OPS_AVX512 R plus(R a, R b) { return _mm512_add_ps(a, b); }
+    OPS_AVX512 R mini(R a, R b) { return _mm512_min_ps(a, b); }
+    OPS_AVX512 R chargerMasque(__mmask16 k, const float* p) { return _mm512_maskz_loadu_ps(k, p); }
+    OPS_AVX512 void rangerMasque(float* p, __mmask16 k, R v) { _mm512_mask_storeu_ps(p, k, v); }
+    OPS_AVX512 __mmask16 inferieur(__mmask16 k, R a, R b) { return _mm512_mask_cmp_ps_mask(k, a, b, _CMP_LT_OQ); }
+};
+
+template<typename T>
+__attribute__((target("avx512f,avx512bw")))
+static void microAVX512(int kc, const T* Ap, const T* Bp, T* C, int ldc) {
+    typedef AVX512<T> V;
+    const int L = V::L;
+    typename V::R acc[8][2];
+    for (int r=0; r<8; r++)
+        for (int s=0; s<2; s++)
+            acc[r][s] = V::charger(C + r*ldc + L*s);
+    for (int p=0; p<kc; p++) {
+        typename V::R b0 = V::charger(Bp + p*2*L);
+        typename V::R b1 = V::charger(Bp + p*2*L + L);
+        for (int r=0; r<8; r++) {
+            typename V::R a = V::diffuser(Ap[p*8+r]);
+            acc[r][0] = V::mini(acc[r][0], V::plus(a, b0));
+            acc[r][1] = V::mini(acc[r][1], V::plus(a, b1));
+        }
+    }
+    for (int r=0; r<8; r++)
+        for (int s=0; s<2; s++)
+            V::ranger(C + r*ldc + L*s, acc[r][s]);
+}
+
+template<typename T>
+__attribute__((target("avx512f,avx512bw")))
+static void ligneAVX512(T* c, T a, const T* b, int n) {
+    typedef AVX512<T> V;
+    typename V::R va = V::diffuser(a);
+    int j = 0;
+    for (; j+V::L<=n; j+=V::L)
+        V::ranger(c+j, V::mini(V::charger(c+j), V::plus(va, V::charger(b+j))));
+    ligneScalaire(c+j, a, b+j, n-j);
+}
+
+template<typename T>
+__attribute__((target("avx512f,avx512bw")))
+static void ligneSuivantAVX512(T* c, int* s, T a, int sa, const T* b, int n) {
+    typedef AVX512<T> V;
+    typename V::R va = V::diffuser(a);
+    __m512i vs = _mm512_set1_epi32(sa);
+    for (int j=0; j<n; j+=16) {
+        __mmask16 k = (n-j >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << (n-j)) - 1);
+        typename V::R vc = V::chargerMasque(k, c+j);
+        typename V::R v = V::plus(va, V::chargerMasque(k, b+j));
+        __mmask16 m = V::inferieur(k, v, vc);
+        V::rangerMasque(c+j, m, v);
+        _mm512_mask_storeu_epi32(s+j, m, vs);
+    }
+}
+
+/* ====================== Sélection à l'exécution ====================== */
+
+/* Entrées des tables : successeurs vectoriels (poids de 32 bits) ou scalaires */
+#define NOYAU(nom, mr, V, suffixe, T) \
+    { nom, mr, 2*V<T>::L, micro##suffixe<T>, ligne##suffixe<T>, ligneSuivant##suffixe<T> }
+#define NOYAU_SANS_SUIVANT(nom, mr, V, suffixe, T) \
+    { nom, mr, 2*V<T>::L, micro##suffixe<T>, ligne##suffixe<T>, ligneSuivantScalaire<T> }
+#define NOYAU_SCALAIRE(T) \
+    { "scalaire", 4, 4, microScalaire<T>, ligneScalaire<T>, ligneSuivantScalaire<T> }
+
+/* Une entrée par niveau (scalaire, SSE4.1, AVX2, AVX-512) ; un niveau sans
+ * instructions adaptées au type reprend le jeu inférieur. */
+template<typename T> static const NoyauMinPlus<T>* noyaux();
+
+template<> const NoyauMinPlus<int16_t>* noyaux<int16_t>() {
+    static const NoyauMinPlus<int16_t> t[] = {
+        NOYAU_SCALAIRE(int16_t),
+        NOYAU_SANS_SUIVANT("sse4.1", 4, SSE4, SSE4, int16_t),
+        NOYAU_SANS_SUIVANT("avx2",   6, AVX2,   AVX2,   int16_t),
+        NOYAU_SANS_SUIVANT("avx512", 8, AVX512, AVX512, int16_t),
+    };
+    return t;
+}
+
+template<> const NoyauMinPlus<int32_t>* noyaux<int32_t>() {
+    static const NoyauMinPlus<int32_t> t[] = {
+        NOYAU_SCALAIRE(int32_t),
+        NOYAU("sse4.1", 4, SSE4,   SSE4,   int32_t),
+        NOYAU("avx2",   6, AVX2,   AVX2,   int32_t),
+        NOYAU("avx512", 8, AVX512, AVX512, int32_t),
+    };
+    return t;
+}
+
+/* SSE4.1 n'a ni minimum ni comparaison sur 64 bits */
+template<> const NoyauMinPlus<int64_t>* noyaux<int64_t>() {
+    static const NoyauMinPlus<int64_t> t[] = {
+        NOYAU_SCALAIRE(int64_t),
+        NOYAU_SCALAIRE(int64_t),
+        NOYAU_SANS_SUIVANT("avx2",   6, AVX2,   AVX2,   int64_t),
+        NOYAU_SANS_SUIVANT("avx512", 8, AVX512, AVX512, int64_t),
+    };
+    return t;
+}
+
+template<> const NoyauMinPlus<float>* noyaux<float>() {
+    static const NoyauMinPlus<float> t[] = {
+        NOYAU_SCALAIRE(float),
+        NOYAU("sse4.1", 4, SSE4,   SSE4,   float),
+        NOYAU("avx2",   6, AVX2,   AVX2,   float),
+        NOYAU("avx512", 8, AVX512, AVX512, float),
+    };
+    return t;
+}
+
+static int choisirNoyau() {
+    __builtin_cpu_init();
+    int niveau = 0;
+    if (__builtin_cpu_supports("sse4.1")) niveau = 1;
+    if (__builtin_cpu_supports("avx2"))   niveau = 2;
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) niveau = 3;
+
+    // FLOYD_SIMD ne peut que restreindre le jeu détecté
+    const char* force = getenv("FLOYD_SIMD");
+    if (force) {
+        int demande = niveau;
+        if (!strcmp(force, "scalaire")) demande = 0;
+        else if (!strncmp(force, "sse4", 4)) demande = 1;
+        else if (!strcmp(force, "avx2")) demande = 2;
+        else if (!strcmp(force, "avx512")) demande = 3;
+        niveau = min(niveau, demande);
+    }
+    return niveau;
+}
+
+template<typename T>
+static const NoyauMinPlus<T>& noyau() {
+    static const int niveau = choisirNoyau();
+    static const NoyauMinPlus<T>& n = noyaux<T>()[niveau];
+    return n;
+}
+
+template<typename T>
+const char* minPlusJeu() {
+    return noyau<T>().nom;
+}
+
+/* ====================== Empaquetage ====================== */
+
+/* A (mc x kc) -> micro-panneaux de mr lignes : Ap[p*mr + r] = A[r][p].
+ * Les lignes manquantes du dernier panneau sont complétées par des 0
+ * (résultats calculés sur ces lignes jamais recopiés). */
+template<typename T>
+static void empaqueterA(int mc, int kc, const T* A, int lda, int mr, T* Ap) {
+    for (int i0=0; i0<mc; i0+=mr) {
+        int h = min(mr, mc-i0);
+        for (int p=0; p<kc; p++) {
+            for (int r=0; r<h; r++)
+                Ap[p*mr + r] = A[(i0+r)*lda + p];
+            for (int r=h; r<mr; r++)
+                Ap[p*mr + r] = 0;
+        }
+        Ap += mr*kc;
+    }
+}
+
+/* B (kc x n) -> micro-panneaux de nr colonnes : Bp[p*nr + s] = B[p][s]. */
+template<typename T>
+static void empaqueterB(int kc, int n, const T* B, int ldb, int nr, T* Bp) {
+    for (int j0=0; j0<n; j0+=nr) {
+        int w = min(nr, n-j0);
+        for (int p=0; p<kc; p++) {
+            const T* src = B + p*ldb + j0;
+            T* dst = Bp + p*nr;
+            for (int s=0; s<w; s++) dst[s] = src[s];
+            for (int s=w; s<nr; s++) dst[s] = 0;
+        }
+        Bp += nr*kc;
+    }
+}
+
+template<typename T>
+void minPlusProduit(int m, int n, int k,
+                    const T* A, int lda,
+                    const T* B, int ldb,
+                    T* C, int ldc) {
+    if (m <= 0 || n <= 0 || k <= 0) return;
+    const NoyauMinPlus<T>& nk = noyau<T>();
+    const int mr = nk.mr, nr = nk.nr;
+
+    // Tampons propres à chaque thread (appel depuis une région OpenMP)
+    static thread_local vector<T> bufA, bufB;
+    int kcMax = min(k, MINPLUS_KC);
+    int mcMax = min(m, MINPLUS_MC);
+    bufA.resize((size_t)((mcMax+mr-1)/mr)*mr*kcMax);
+    bufB.resize((size_t)((n+nr-1)/nr)*nr*kcMax);
+    T bord[8*64] = {};
+
+    for (int pc=0; pc<k; pc+=MINPLUS_KC) {
+        int kc = min(MINPLUS_KC, k-pc);
+        empaqueterB(kc, n, B + (size_t)pc*ldb, ldb, nr, bufB.data());
+
+        for (int ic=0; ic<m; ic+=MINPLUS_MC) {
+            int mc = min(MINPLUS_MC, m-ic);
+            empaqueterA(mc, kc, A + (size_t)ic*lda + pc, lda, mr, bufA.data());
+
+            for (int jr=0; jr<n; jr+=nr) {
+                const T* Bp = bufB.data() + (size_t)(jr/nr)*nr*kc;
+                int w = min(nr, n-jr);
+                for (int ir=0; ir<mc; ir+=mr) {
+                    const T* Ap = bufA.data() + (size_t)(ir/mr)*mr*kc;
+                    int h = min(mr, mc-ir);
+                    T* Cij = C + (size_t)(ic+ir)*ldc + jr;
+                    if (h == mr && w == nr) {
+                        nk.micro(kc, Ap, Bp, Cij, ldc);
+                    } else {
+                        // Micro-bloc de bord : passage par un tampon plein
+                        for (int r=0; r<h; r++)
+                            copy(Cij + r*ldc, Cij + r*ldc + w, bord + r*nr);
+                        nk.micro(kc, Ap, Bp, bord, nr);
+                        for (int r=0; r<h; r++)
+                            copy(bord + r*nr, bord + r*nr + w, Cij + r*ldc);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+void minPlusEnPlace(int m, int n, int k,
+                    const T* A, int lda,
+                    const T* B, int ldb,
+                    T* C, int ldc) {
+    const NoyauMinPlus<T>& nk = noyau<T>();
+    for (int kk=0; kk<k; kk++) {
+        const T* Bk = B + (size_t)kk*ldb;
+        for (int i=0; i<m; i++)
+            nk.ligne(C + (size_t)i*ldc, A[(size_t)i*lda + kk], Bk, n);
+    }
+}
+
+template<typename T>
+void minPlusSuivant(int m, int n, int k,
+                    const T* A, const int* SA, int lda,
+                    const T* B, int ldb,
+                    T* C, int* SC, int ldc) {
+    const NoyauMinPlus<T>& nk = noyau<T>();
+    for (int kk=0; kk<k; kk++) {
+        const T* Bk = B + (size_t)kk*ldb;
+        for (int i=0; i<m; i++)
+            nk.ligneSuivant(C + (size_t)i*ldc, SC + (size_t)i*ldc,
+                            A[(size_t)i*lda + kk], SA[(size_t)i*lda + kk], Bk, n);
+    }
+}
+
+/* Instanciations pour les types de poids de Poids.hpp */
+#define INSTANCIER_MINPLUS(T) \
+    template void minPlusProduit<T>(int, int, int, const T*, int, const T*, int, T*, int); \
+    template void minPlusEnPlace<T>(int, int, int, const T*, int, const T*, int, T*, int); \
+    template void minPlusSuivant<T>(int, int, int, const T*, const int*, int, const T*, int, \
+                                    T*, int*, int); \
+    template const char* minPlusJeu<T>();
+INSTANCIER_MINPLUS(int16_t)
+INSTANCIER_MINPLUS(int32_t)
+INSTANCIER_MINPLUS(int64_t)
+INSTANCIER_MINPLUS(float)
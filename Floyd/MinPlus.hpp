@@ -0,0 +1,85 @@
+#ifndef MINPLUS_HPP
+#define MINPLUS_HPP
+
+/**
+ * @brief Noyaux (min,+) partagés par les phases de Floyd-Warshall par blocs.
+ *
+ * Le jeu d'instructions (scalaire, SSE4.1, AVX2, AVX-512) est choisi une seule
+ * fois à l'exécution selon le processeur. La variable d'environnement
+ * FLOYD_SIMD (scalaire, sse4, avx2, avx512) permet d'imposer un jeu moins
+ * large, par exemple pour comparer les performances.
+ *
+ * Les noyaux sont instanciés pour chaque type de poids de Poids.hpp
+ * (int16_t, int32_t, int64_t, float). Les sommes ne sont pas testées contre
+ * la sentinelle : l'addition est saturante (adds_epi16 pour int16_t,
+ * sentinelle à MAX / 2 pour int32_t et int64_t, +infini pour float), donc
+ * A[i][k] + B[k][j] >= infini dès qu'un des termes vaut infini, ce qui ne
+ * peut jamais faire baisser C[i][j] (<= infini).
+ *
+ * Pour int16_t, les registres contiennent deux fois plus de poids qu'en
+ * int32_t : à jeu d'instructions égal, un produit (min,+) traite deux fois
+ * plus d'éléments par instruction. Les successeurs (minPlusSuivant) restent
+ * des int : la variante vectorielle n'existe que pour les poids de 32 bits,
+ * les autres types utilisent la boucle scalaire.
+ */
+
+#include "Poids.hpp"
+
+/**
+ * @brief Produit (min,+) accumulé : C[i][j] = min(C[i][j], A[i][kk] + B[kk][j])
+ *        pour tout kk. Version empaquetée et bloquée en registres (style BLIS),
+ *        réservée au cas où C ne recouvre ni A ni B (phase 5).
+ *
+ * @param m nombre de lignes de A et C
+ * @param n nombre de colonnes de B et C
+ * @param k nombre de colonnes de A (lignes de B)
+ * @param A matrice m x k, pas de ligne lda
+ * @param lda pas de ligne de A
+ * @param B matrice k x n, pas de ligne ldb
+ * @param ldb pas de ligne de B
+ * @param C matrice m x n mise à jour, pas de ligne ldc
+ * @param ldc pas de ligne de C
+ */
+template<typename T>
+void minPlusProduit(int m, int n, int k,
+                    const T* A, int lda,
+                    const T* B, int ldb,
+                    T* C, int ldc);
+
+/**
+ * @brief Même mise à jour que minPlusProduit mais dans l'ordre de Floyd-Warshall
+ *        (boucle kk la plus externe), ce qui autorise A ou B à être C lui-même
+ *        (bloc diagonal, blocs de la ligne ou de la colonne pivot).
+ *
+ * @note Correct tant que les diagonales des blocs pivots sont >= 0
+ *       (pas de cycle négatif).
+ */
+template<typename T>
+void minPlusEnPlace(int m, int n, int k,
+                    const T* A, int lda,
+                    const T* B, int ldb,
+                    T* C, int ldc);
+
+/**
+ * @brief Variante de minPlusEnPlace qui maintient les successeurs (prochain
+ *        sommet sur le chemin) : quand C[i][j] diminue strictement par kk,
+ *        SC[i][j] prend la valeur SA[i][kk], comme dans la version séquentielle
+ *        avec next. Même ordre que minPlusEnPlace, donc A/SA peuvent être C/SC.
+ *
+ * @param SA successeurs associés à A (même pas de ligne lda)
+ * @param SC successeurs associés à C (même pas de ligne ldc)
+ */
+template<typename T>
+void minPlusSuivant(int m, int n, int k,
+                    const T* A, const int* SA, int lda,
+                    const T* B, int ldb,
+                    T* C, int* SC, int ldc);
+
+/**
+ * @brief Nom du jeu d'instructions retenu pour le type T ("scalaire",
+ *        "sse4.1", "avx2", "avx512")
+ */
+template<typename T = int>
+const char* minPlusJeu();
+
+#endif
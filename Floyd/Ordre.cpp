@@ -0,0 +1,216 @@
+#include "Ordre.hpp"
+
+#include <omp.h>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+
+using namespace std;
+
+/* Parcours en largeur depuis s : file reçoit les sommets atteints dans
+ * l'ordre de visite, niveau leur distance en arêtes (niveau doit valoir -1
+ * partout ; il est remis à -1 par l'appelant). Rend le niveau maximal. */
+static int parcours(const GrapheCSR& g, int s, vector<int>& niveau, vector<int>& file) {
+    file.clear();
+    file.push_back(s);
+    niveau[s] = 0;
+    for (size_t t = 0; t < file.size(); t++) {
+        int u = file[t];
+        for (long a = g.debut[u]; a < g.debut[u+1]; a++) {
+            int v = g.voisins[a];
+            if (niveau[v] < 0) {
+                niveau[v] = niveau[u] + 1;
+                file.push_back(v);
+            }
+        }
+    }
+    return niveau[file.back()];
+}
+
+/* Sommet pseudo-périphérique de la composante de s (George-Liu) : tant
+ * que l'excentricité augmente, repartir du sommet de degré minimal du
+ * dernier niveau */
+static int peripherique(const GrapheCSR& g, const vector<int>& degre, int s,
+                        vector<int>& niveau, vector<int>& file) {
+    int excentricite = -1;
+    for (int essai = 0; essai < 8; essai++) {
+        int e = parcours(g, s, niveau, file);
+        int suivant = s;
+        for (size_t t = file.size(); t-- > 0 && niveau[file[t]] == e; )
+            if (suivant == s || degre[file[t]] < degre[suivant]) suivant = file[t];
+        for (int u : file) niveau[u] = -1;
+        if (e <= excentricite) break;
+        excentricite = e;
+        s = suivant;
+    }
+    return s;
+}
+
+vector<int> ordreCuthillMcKee(const GrapheCSR& g) {
+    int n = g.n;
+    vector<int> degre(n);
+    for (int u = 0; u < n; u++) degre[u] = (int)(g.debut[u+1] - g.debut[u]);
+
+    // Le premier sommet non visité par degré croissant est de degré
+    // minimal dans sa composante
+    vector<int> par_degre(n);
+    iota(par_degre.begin(), par_degre.end(), 0);
+    stable_sort(par_degre.begin(), par_degre.end(),
+                [&degre](int a, int b) { return degre[a] < degre[b]; });
+
+    vector<int> ordre, niveau(n, -1), file, voisins;
+    vector<char> vu(n, 0);
+    ordre.reserve(n);
+    for (int s : par_degre) {
+        if (vu[s]) continue;
+        s = peripherique(g, degre, s, niveau, file);
+        size_t tete = ordre.size();
+        ordre.push_back(s);
+        vu[s] = 1;
+        while (tete < ordre.size()) {
+            int u = ordre[tete++];
+            voisins.clear();
+            for (long a = g.debut[u]; a < g.debut[u+1]; a++) {
+                int v = g.voisins[a];
+                if (!vu[v]) {
+                    vu[v] = 1;
+                    voisins.push_back(v);
+                }
+            }
+            stable_sort(voisins.begin(), voisins.end(),
+                        [&degre](int a, int b) { return degre[a] < degre[b]; });
+            ordre.insert(ordre.end(), voisins.begin(), voisins.end());
+        }
+    }
+    reverse(ordre.begin(), ordre.end());
+    return ordre;
+}
+
+vector<int> ordreMedoides(const GrapheCSR& g, int k) {
+    int n = g.n;
+    k = max(1, min(k, n));
+    vector<int> distance(n, INT_MAX), germe(n, -1), file, source;
+
+    // Premier germe : le sommet de plus haut degré
+    int s = 0;
+    for (int u = 1; u < n; u++)
+        if (g.debut[u+1] - g.debut[u] > g.debut[s+1] - g.debut[s]) s = u;
+    for (int x = 0; x < k && n > 0; x++) {
+        // Parcours élagué : seuls les sommets que ce germe rapproche sont revus
+        distance[s] = 0;
+        germe[s] = x;
+        file.assign(1, s);
+        for (size_t t = 0; t < file.size(); t++) {
+            int u = file[t];
+            for (long a = g.debut[u]; a < g.debut[u+1]; a++) {
+                int v = g.voisins[a];
+                if (distance[u] + 1 < distance[v]) {
+                    distance[v] = distance[u] + 1;
+                    germe[v] = x;
+                    file.push_back(v);
+                }
+            }
+        }
+        if (x == 0) source = distance;
+        // Germe suivant : le sommet le plus éloigné des germes déjà choisis
+        s = (int)(max_element(distance.begin(), distance.end()) - distance.begin());
+        if (distance[s] == 0) break;
+    }
+
+    // Groupes rangés par distance de leur germe au premier germe, pour que
+    // des régions voisines aient des blocs voisins
+    vector<int> germes;
+    for (int u = 0; u < n; u++)
+        if (distance[u] == 0) germes.push_back(u);
+    vector<int> par_source(germes.size());
+    iota(par_source.begin(), par_source.end(), 0);
+    stable_sort(par_source.begin(), par_source.end(), [&](int a, int b) {
+        return source[germes[a]] != source[germes[b]] ? source[germes[a]] < source[germes[b]]
+                                                      : germe[germes[a]] < germe[germes[b]];
+    });
+    vector<int> groupe(germes.size());
+    for (size_t x = 0; x < germes.size(); x++) groupe[germe[germes[par_source[x]]]] = (int)x;
+
+    // Sommets qu'aucun germe n'atteint (plus de composantes que de germes) :
+    // un dernier groupe, dans leur ordre d'origine
+    int hors_groupe = (int)germes.size();
+    auto groupeDe = [&](int u) { return germe[u] < 0 ? hors_groupe : groupe[germe[u]]; };
+
+    vector<int> ordre(n);
+    iota(ordre.begin(), ordre.end(), 0);
+    stable_sort(ordre.begin(), ordre.end(), [&](int a, int b) {
+        int ga = groupeDe(a), gb = groupeDe(b);
+        return ga != gb ? ga < gb : distance[a] < distance[b];
+    });
+    return ordre;
+}
+
+GrapheCSR permuterCSR(const GrapheCSR& g, const vector<int>& ordre) {
+    int n = g.n;
+    vector<int> place(n);
+    for (int i = 0; i < n; i++) place[ordre[i]] = i;
+
+    GrapheCSR h;
+    h.n = n;
+    h.debut.assign(n+1, 0);
+    for (int i = 0; i < n; i++)
+        h.debut[i+1] = h.debut[i] + (g.debut[ordre[i]+1] - g.debut[ordre[i]]);
+    h.voisins.resize(g.voisins.size());
+    h.poids.resize(g.poids.size());
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int i = 0; i < n; i++) {
+        // Voisins rangés par numéro croissant, comme csrDepuisAretes
+        vector<pair<int,int> > arcs;
+        int u = ordre[i];
+        for (long a = g.debut[u]; a < g.debut[u+1]; a++)
+            arcs.push_back(make_pair(place[g.voisins[a]], g.poids[a]));
+        sort(arcs.begin(), arcs.end());
+        for (size_t a = 0; a < arcs.size(); a++) {
+            h.voisins[h.debut[i] + a] = arcs[a].first;
+            h.poids[h.debut[i] + a] = arcs[a].second;
+        }
+    }
+    return h;
+}
+
+void largeurBande(const GrapheCSR& g, int* largeur, double* moyenne) {
+    long long somme = 0;
+    int l = 0;
+    for (int u = 0; u < g.n; u++)
+        for (long a = g.debut[u]; a < g.debut[u+1]; a++) {
+            int d = abs(u - g.voisins[a]);
+            somme += d;
+            l = max(l, d);
+        }
+    *largeur = l;
+    *moyenne = g.voisins.empty() ? 0 : (double)somme / g.voisins.size();
+}
+
+template<typename T>
+T* permuterMatrice(const T* M, int n, const vector<int>& ordre, bool inverse) {
+    vector<int> o(n);
+    for (int i = 0; i < n; i++) o[i] = (i < (int)ordre.size()) ? ordre[i] : i;
+    T* R = new T[(long)n * n];
+    #pragma omp parallel for
+    for (int i = 0; i < n; i++) {
+        if (inverse) {
+            T* Ri = R + (long)o[i] * n;
+            const T* Mi = M + (long)i * n;
+            for (int j = 0; j < n; j++) Ri[o[j]] = Mi[j];
+        } else {
+            T* Ri = R + (long)i * n;
+            const T* Mi = M + (long)o[i] * n;
+            for (int j = 0; j < n; j++) Ri[j] = Mi[o[j]];
+        }
+    }
+    return R;
+}
+
+/* Instanciations pour les types de poids de Poids.hpp (int32_t sert aussi
+ * à la matrice 0/1 de l'accessibilité) */
+template int16_t* permuterMatrice<int16_t>(const int16_t*, int, const vector<int>&, bool);
+template int32_t* permuterMatrice<int32_t>(const int32_t*, int, const vector<int>&, bool);
+template int64_t* permuterMatrice<int64_t>(const int64_t*, int, const vector<int>&, bool);
+template float* permuterMatrice<float>(const float*, int, const vector<int>&, bool);
@@ -0,0 +1,64 @@
+#ifndef ORDRE_HPP
+#define ORDRE_HPP
+
+#include <vector>
+#include "Dijkstra.hpp"
+
+using namespace std;
+
+/**
+ * @brief Renumérotations des sommets avant le Floyd distribué, pour
+ *        concentrer les entrées finies près de la diagonale de blocs.
+ *
+ * Un ordre est un vecteur ordre de n sommets : le sommet d'origine
+ * ordre[i] devient le sommet i.
+ */
+
+/**
+ * @brief Ordre de Cuthill-McKee inverse : parcours en largeur de chaque
+ *        composante depuis un sommet pseudo-périphérique (degré minimal,
+ *        puis extrémité d'un parcours en largeur), voisins pris par degré
+ *        croissant, l'ordre obtenu étant renversé. Réduit la largeur de
+ *        bande de la matrice d'adjacence. O(m log d).
+ */
+vector<int> ordreCuthillMcKee(const GrapheCSR& g);
+
+/**
+ * @brief Ordre par médoïdes : k germes choisis du plus éloigné au plus
+ *        éloigné (en nombre d'arêtes, le premier étant de degré maximal ;
+ *        un sommet d'une composante sans germe est infiniment loin), puis
+ *        chaque sommet rattaché au germe le plus proche par un parcours en
+ *        largeur multi-sources. Les sommets sont rangés par germe, puis par
+ *        distance à leur germe : chaque groupe forme une bande de blocs
+ *        diagonaux ; les sommets qu'aucun germe n'atteint forment un
+ *        dernier groupe. Variante rapide de l'affectation de PAM, sans
+ *        matrice de distances. O(k m).
+ *
+ * @param k Nombre de germes (typiquement le nombre de blocs par dimension)
+ */
+vector<int> ordreMedoides(const GrapheCSR& g, int k);
+
+/**
+ * @brief Graphe renuméroté : le sommet ordre[i] devient i
+ */
+GrapheCSR permuterCSR(const GrapheCSR& g, const vector<int>& ordre);
+
+/**
+ * @brief Largeur de bande (max |i - j| sur les arêtes) et écart moyen à la
+ *        diagonale (moyenne de |i - j|) de la matrice d'adjacence
+ */
+void largeurBande(const GrapheCSR& g, int* largeur, double* moyenne);
+
+/**
+ * @brief Permutation symétrique d'une matrice n x n : M'[i][j] =
+ *        M[ordre[i]][ordre[j]], ou l'inverse (M'[ordre[i]][ordre[j]] =
+ *        M[i][j]) pour revenir à la numérotation d'origine. Les indices au-delà
+ *        de ordre.size() (sommets ajoutés après la renumérotation) restent
+ *        en place.
+ *
+ * @return T* Nouvelle matrice n x n (M n'est pas libérée)
+ */
+template<typename T>
+T* permuterMatrice(const T* M, int n, const vector<int>& ordre, bool inverse);
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef POIDS_HPP
+#define POIDS_HPP
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Caractéristiques d'un type de poids pour Floyd-Warshall : valeur
+ *        sentinelle (infini) et addition saturante.
+ *
+ * L'addition saturante garantit que a + b >= infini dès qu'un des termes vaut
+ * infini, sans débordement, de sorte qu'une somme passant par un sommet non
+ * relié ne fait jamais baisser une distance (<= infini) :
+ *  - int16_t : sentinelle INT16_MAX, addition saturée (adds_epi16 en SIMD) ;
+ *  - int32_t, int64_t : sentinelle au milieu de l'intervalle (MAX / 2),
+ *    la somme de deux valeurs <= infini ne déborde jamais ;
+ *  - float : +infini IEEE, qui sature de lui-même (distances entières
+ *    exactes jusqu'à 2^24).
+ *
+ * Toutes les distances réelles doivent rester strictement inférieures à la
+ * sentinelle : choisirTypePoids s'en charge à partir du poids maximal.
+ */
+template<typename T> struct Poids;
+
+template<> struct Poids<int16_t> {
+    static constexpr int16_t infini() { return INT16_MAX; }
+    static int16_t plus(int16_t a, int16_t b) {
+        int s = a + b;
+        return (int16_t)(s > INT16_MAX ? INT16_MAX : (s < INT16_MIN ? INT16_MIN : s));
+    }
+    static const char* nom() { return "int16"; }
+};
+
+template<> struct Poids<int32_t> {
+    static constexpr int32_t infini() { return INT32_MAX / 2; }
+    static int32_t plus(int32_t a, int32_t b) { return a + b; }
+    static const char* nom() { return "int32"; }
+};
+
+template<> struct Poids<int64_t> {
+    static constexpr int64_t infini() { return INT64_MAX / 2; }
+    static int64_t plus(int64_t a, int64_t b) { return a + b; }
+    static const char* nom() { return "int64"; }
+};
+
+template<> struct Poids<float> {
+    static constexpr float infini() { return std::numeric_limits<float>::infinity(); }
+    static float plus(float a, float b) { return a + b; }
+    static const char* nom() { return "float"; }
+};
+
+/**
+ * @brief Types de poids disponibles pour le calcul dense
+ */
+enum TypePoids { POIDS_INT16, POIDS_INT32, POIDS_INT64, POIDS_FLOAT };
+
+/**
+ * @brief Borne de la longueur d'un plus court chemin : il compte au plus
+ *        n-1 arêtes, d'où poids_max * (n-1)
+ *
+ * @param poids_max Plus grand poids d'arête (en valeur absolue)
+ * @param n Nombre de sommets
+ */
+inline double borneDistances(long poids_max, int n) {
+    return (double)poids_max * (n > 1 ? n-1 : 1);
+}
+
+/**
+ * @brief Plus petit type entier dont la sentinelle dépasse toute distance
+ *        possible (borneDistances)
+ */
+inline TypePoids choisirTypePoids(long poids_max, int n) {
+    double borne = borneDistances(poids_max, n);
+    if (borne < Poids<int16_t>::infini()) return POIDS_INT16;
+    if (borne < Poids<int32_t>::infini()) return POIDS_INT32;
+    return POIDS_INT64;
+}
+
+/**
+ * @brief Vrai si toutes les distances possibles restent sous la sentinelle
+ *        du type t (même borne que choisirTypePoids). float est toujours
+ *        accepté : seule l'exactitude se perd au-delà de 2^24.
+ */
+inline bool typePoidsSuffit(TypePoids t, long poids_max, int n) {
+    double borne = borneDistances(poids_max, n);
+    switch (t) {
+        case POIDS_INT16: return borne < Poids<int16_t>::infini();
+        case POIDS_INT32: return borne < Poids<int32_t>::infini();
+        case POIDS_INT64: return borne < (double)Poids<int64_t>::infini();
+        default:          return true;
+    }
+}
+
+/**
+ * @brief Nom d'un type de poids ("int16", "int32", "int64", "float")
+ */
+inline const char* nomTypePoids(TypePoids t) {
+    switch (t) {
+        case POIDS_INT16: return Poids<int16_t>::nom();
+        case POIDS_INT32: return Poids<int32_t>::nom();
+        case POIDS_INT64: return Poids<int64_t>::nom();
+        default:          return Poids<float>::nom();
+    }
+}
+
+#endif
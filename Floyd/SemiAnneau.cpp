@@ -0,0 +1,80 @@
+#include "SemiAnneau.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+/* c[j] = max(c[j], min(a, b[j])) : boucle simple vectorisée par le
+ * compilateur (omp simd), c et b pouvant coïncider */
+template<typename T>
+static inline void ligneMaxMin(T* c, T a, const T* b, int n) {
+    #pragma omp simd
+    for (int j=0; j<n; j++) {
+        T v = b[j] < a ? b[j] : a;
+        c[j] = c[j] < v ? v : c[j];
+    }
+}
+
+template<typename T>
+void maxMinEnPlace(int m, int n, int k,
+                   const T* A, int lda,
+                   const T* B, int ldb,
+                   T* C, int ldc) {
+    for (int kk=0; kk<k; kk++) {
+        const T* Bk = B + (size_t)kk*ldb;
+        for (int i=0; i<m; i++)
+            ligneMaxMin(C + (size_t)i*ldc, A[(size_t)i*lda + kk], Bk, n);
+    }
+}
+
+template<typename T>
+void maxMinProduit(int m, int n, int k,
+                   const T* A, int lda,
+                   const T* B, int ldb,
+                   T* C, int ldc) {
+    // Une ligne de C reste en cache pendant tout le parcours de kk ; un
+    // terme A[i][kk] nul (pas de chemin) ne peut rien apporter
+    for (int i=0; i<m; i++) {
+        T* Ci = C + (size_t)i*ldc;
+        const T* Ai = A + (size_t)i*lda;
+        for (int kk=0; kk<k; kk++)
+            if (Ai[kk] > 0)
+                ligneMaxMin(Ci, Ai[kk], B + (size_t)kk*ldb, n);
+    }
+}
+
+void boolEnPlace(int m, int k, int w, const uint64_t* A, const uint64_t* B, uint64_t* C) {
+    for (int kk=0; kk<k; kk++) {
+        const uint64_t* Bk = B + (size_t)kk*w;
+        for (int i=0; i<m; i++)
+            if ((A[(size_t)i*w + kk/64] >> (kk%64)) & 1) {
+                uint64_t* Ci = C + (size_t)i*w;
+                for (int q=0; q<w; q++) Ci[q] |= Bk[q];
+            }
+    }
+}
+
+void boolProduit(int m, int k, int w, const uint64_t* A, const uint64_t* B, uint64_t* C) {
+    for (int i=0; i<m; i++) {
+        uint64_t* Ci = C + (size_t)i*w;
+        const uint64_t* Ai = A + (size_t)i*w;
+        for (int q=0; q*64<k; q++) {
+            uint64_t bits = Ai[q];
+            while (bits) {
+                int kk = q*64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                const uint64_t* Bk = B + (size_t)kk*w;
+                for (int r=0; r<w; r++) Ci[r] |= Bk[r];
+            }
+        }
+    }
+}
+
+/* Instanciations pour les types de poids de Poids.hpp */
+#define INSTANCIER_MAXMIN(T) \
+    template void maxMinEnPlace<T>(int, int, int, const T*, int, const T*, int, T*, int); \
+    template void maxMinProduit<T>(int, int, int, const T*, int, const T*, int, T*, int);
+INSTANCIER_MAXMIN(int16_t)
+INSTANCIER_MAXMIN(int32_t)
+INSTANCIER_MAXMIN(int64_t)
+INSTANCIER_MAXMIN(float)
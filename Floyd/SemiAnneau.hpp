@@ -0,0 +1,134 @@
+#ifndef SEMIANNEAU_HPP
+#define SEMIANNEAU_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include "Poids.hpp"
+
+/**
+ * @brief Semi-anneaux de la fermeture par blocs (paramètre S de
+ *        fermetureBlocsLocal).
+ *
+ * Chaque semi-anneau fixe le type T des éléments stockés, le nombre
+ * d'éléments T par ligne d'un bloc nb x nb (mots), l'élément « pas de
+ * chemin » (neutre de ⊕) et la valeur de la diagonale (neutre de ⊗).
+ * La fermeture de Floyd-Warshall par blocs est valable pour les trois :
+ * la diagonale fermée vaut l'unité, ce qui permet les mises à jour en place
+ * des panneaux pivots.
+ *
+ *  - MinPlus<P>   : plus courts chemins, C = min(C, A + B) (noyaux MinPlus.hpp)
+ *  - MaxMin<P>    : chemins de goulot (largeur maximale), C = max(C, min(A, B))
+ *  - Accessibilite: fermeture transitive, blocs compactés à 64 sommets par
+ *                   mot, C |= A & B traité 64 colonnes à la fois
+ *
+ * vide(r) dit si une tuile de résumé r ne contient que le neutre, et
+ * sansEffet(a, b, c) si C ⊕= A ⊗ B ne peut modifier aucun élément de C
+ * d'après les résumés de A, B et C (toujours vrai si A ou B est vide).
+ */
+
+/**
+ * @brief Résumé d'une tuile (bloc ou bande de lignes d'un bloc) : plus
+ *        petit et plus grand élément stocké. En accessibilité, haut est nul
+ *        si et seulement si la tuile ne contient aucun bit levé.
+ */
+template<typename T>
+struct Resume {
+    T bas, haut;
+};
+
+template<typename T>
+inline Resume<T> resumer(const T* X, long taille) {
+    Resume<T> r = {X[0], X[0]};
+    for (long i = 1; i < taille; i++) {
+        r.bas = std::min(r.bas, X[i]);
+        r.haut = std::max(r.haut, X[i]);
+    }
+    return r;
+}
+
+template<typename T>
+inline void joindre(Resume<T>& r, const Resume<T>& x) {
+    r.bas = std::min(r.bas, x.bas);
+    r.haut = std::max(r.haut, x.haut);
+}
+
+/* (min,+) : A ⊗ B vaut au moins min A + min B, avec la même addition
+ * saturante que les noyaux */
+template<typename P>
+struct MinPlus {
+    typedef P T;
+    static int mots(int nb) { return nb; }
+    static T neutre() { return Poids<P>::infini(); }
+    static T unite() { return 0; }
+    static bool vide(const Resume<T>& r) { return r.bas >= neutre(); }
+    static bool sansEffet(const Resume<T>& a, const Resume<T>& b, const Resume<T>& c) {
+        return vide(a) || vide(b) || Poids<P>::plus(a.bas, b.bas) >= c.haut;
+    }
+};
+
+/* (max,min) : A ⊗ B vaut au plus min(max A, max B) */
+template<typename P>
+struct MaxMin {
+    typedef P T;
+    static int mots(int nb) { return nb; }
+    static T neutre() { return 0; }
+    static T unite() { return Poids<P>::infini(); }
+    static bool vide(const Resume<T>& r) { return r.haut <= neutre(); }
+    static bool sansEffet(const Resume<T>& a, const Resume<T>& b, const Resume<T>& c) {
+        return vide(a) || vide(b) || std::min(a.haut, b.haut) <= c.bas;
+    }
+};
+
+struct Accessibilite {
+    typedef uint64_t T;
+    static int mots(int nb) { return (nb + 63) / 64; }
+    static bool vide(const Resume<T>& r) { return r.haut == 0; }
+    static bool sansEffet(const Resume<T>& a, const Resume<T>& b, const Resume<T>&) {
+        return vide(a) || vide(b);
+    }
+};
+
+/**
+ * @brief Noyau (max,min) : C[i][j] = max(C[i][j], min(A[i][kk], B[kk][j]))
+ *        pour tout kk, dans l'ordre de Floyd-Warshall (kk le plus externe) ;
+ *        A ou B peuvent être C lui-même tant que la diagonale des blocs
+ *        pivots vaut l'unité (Poids<T>::infini()).
+ */
+template<typename T>
+void maxMinEnPlace(int m, int n, int k,
+                   const T* A, int lda,
+                   const T* B, int ldb,
+                   T* C, int ldc);
+
+/**
+ * @brief Même mise à jour que maxMinEnPlace quand C ne recouvre ni A ni B
+ *        (phase 5) : les lignes de C sont traitées une à une, en registres.
+ */
+template<typename T>
+void maxMinProduit(int m, int n, int k,
+                   const T* A, int lda,
+                   const T* B, int ldb,
+                   T* C, int ldc);
+
+/**
+ * @brief Fermeture transitive en place d'un bloc compacté nb x nb (Warshall
+ *        sur des lignes de w mots) : pour chaque kk, toute ligne i dont le
+ *        bit kk est levé reçoit C[i] |= B[kk].
+ *
+ * @param m nombre de lignes de C (et de A)
+ * @param k nombre de pivots kk
+ * @param w nombre de mots par ligne
+ * @param A lignes dont les bits kk sont testés (peut être C)
+ * @param B lignes pivots (peut être C)
+ * @param C lignes mises à jour
+ */
+void boolEnPlace(int m, int k, int w, const uint64_t* A, const uint64_t* B, uint64_t* C);
+
+/**
+ * @brief C |= A ⊗ B sans recouvrement (phase 5) : les bits levés de chaque
+ *        mot de A sont parcourus directement (ctz), chacun ajoutant une
+ *        ligne de B par OU sur w mots, soit 64 colonnes par opération.
+ */
+void boolProduit(int m, int k, int w, const uint64_t* A, const uint64_t* B, uint64_t* C);
+
+#endif
@@ -0,0 +1,92 @@
+#include "StockTuiles.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <omp.h>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace std;
+
+/* Lecture ou écriture complète de len octets à la position pos */
+static bool transfert(int fd, char* p, long len, long long pos, bool ecrire) {
+    while (len > 0) {
+        ssize_t r = ecrire ? pwrite(fd, p, len, pos) : pread(fd, p, len, pos);
+        if (r <= 0) return false;
+        p += r; len -= r; pos += r;
+    }
+    return true;
+}
+
+static void transfererCadre(StockTuiles& s, int c, bool ecrire) {
+    long t = s.tuile_cadre[c];
+    double t0 = omp_get_wtime();
+    if (!transfert(s.fd, s.cadres + (long)c * s.taille, s.taille, s.base + (long long)t * s.taille, ecrire)) {
+        perror(ecrire ? "StockTuiles : écriture" : "StockTuiles : lecture");
+        abort();
+    }
+    s.temps += omp_get_wtime() - t0;
+    (ecrire ? s.ecrits : s.lus) += s.taille;
+}
+
+int ouvrirStock(StockTuiles* s, const char* f, long long base, long nb_tuiles,
+                long taille, int capacite) {
+    s->fd = open(f, O_RDWR | O_CREAT, 0644);
+    if (s->fd < 0) return -1;
+    s->base = base;
+    s->taille = taille;
+    s->nb_tuiles = nb_tuiles;
+    s->capacite = (int)max(1L, min((long)capacite, nb_tuiles));
+    s->cadres = new char[(long)s->capacite * taille];
+    s->tuile_cadre.assign(s->capacite, -1);
+    s->cadre_tuile.assign(nb_tuiles, -1);
+    s->sale.assign(s->capacite, 0);
+    s->usage.assign(s->capacite, 0);
+    s->horloge = 0;
+    s->lus = s->ecrits = 0;
+    s->temps = 0;
+    return 0;
+}
+
+char* tuile(StockTuiles& s, long t, AccesTuile acces) {
+    int c = s.cadre_tuile[t];
+    if (c < 0) {
+        // Cadre libre ou le moins récemment utilisé
+        c = 0;
+        for (int x = 1; x < s.capacite && s.tuile_cadre[c] >= 0; x++)
+            if (s.tuile_cadre[x] < 0 || s.usage[x] < s.usage[c]) c = x;
+        if (s.tuile_cadre[c] >= 0) {
+            if (s.sale[c]) transfererCadre(s, c, true);
+            s.cadre_tuile[s.tuile_cadre[c]] = -1;
+        }
+        s.tuile_cadre[c] = t;
+        s.cadre_tuile[t] = c;
+        s.sale[c] = 0;
+        if (acces != TUILE_NOUVELLE) transfererCadre(s, c, false);
+    }
+    s.usage[c] = ++s.horloge;
+    if (acces != TUILE_LECTURE) s.sale[c] = 1;
+    return s.cadres + (long)c * s.taille;
+}
+
+void anticiperTuile(StockTuiles& s, long t) {
+    if (s.cadre_tuile[t] < 0)
+        posix_fadvise(s.fd, s.base + (long long)t * s.taille, s.taille, POSIX_FADV_WILLNEED);
+}
+
+void viderStock(StockTuiles& s) {
+    for (int c = 0; c < s.capacite; c++)
+        if (s.tuile_cadre[c] >= 0 && s.sale[c]) {
+            transfererCadre(s, c, true);
+            s.sale[c] = 0;
+        }
+}
+
+void fermerStock(StockTuiles& s) {
+    viderStock(s);
+    delete[] s.cadres;
+    s.cadres = nullptr;
+    close(s.fd);
+    s.fd = -1;
+}
@@ -0,0 +1,79 @@
+#ifndef STOCKTUILES_HPP
+#define STOCKTUILES_HPP
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Magasin de tuiles sur disque avec un cache borné en mémoire, pour
+ *        les calculs hors mémoire (floydHorsMemoire).
+ *
+ * Les nb_tuiles tuiles de taille fixe sont rangées à la suite dans une région
+ * d'un fichier (à partir de base) ; seules `capacite` tuiles sont en mémoire
+ * à la fois. Une tuile absente est lue (pread) dans le cadre le moins
+ * récemment utilisé, dont la tuile est d'abord réécrite (pwrite) si elle a
+ * été modifiée. anticiperTuile demande au noyau de lire une tuile à l'avance
+ * (posix_fadvise) pendant que le calcul continue.
+ *
+ * Non thread-safe : les tuiles sont chargées par un seul thread, puis
+ * traitées en parallèle tant qu'aucune autre n'est chargée.
+ */
+struct StockTuiles {
+    int fd;                     /**< Fichier des tuiles */
+    long long base;             /**< Début de la région (octets) */
+    long taille;                /**< Octets d'une tuile */
+    long nb_tuiles;             /**< Tuiles de la région */
+    int capacite;               /**< Cadres en mémoire */
+    char* cadres;               /**< capacite * taille octets */
+    vector<long> tuile_cadre;   /**< Tuile de chaque cadre (-1 : libre) */
+    vector<int> cadre_tuile;    /**< Cadre de chaque tuile (-1 : sur disque) */
+    vector<char> sale;          /**< Cadre modifié depuis sa lecture */
+    vector<long> usage;         /**< Dernier accès de chaque cadre */
+    long horloge;
+    long long lus, ecrits;      /**< Octets lus et écrits */
+    double temps;               /**< Temps passé en lectures/écritures */
+};
+
+/**
+ * @brief Accès à une tuile : lecture seule, modification, ou tuile
+ *        entièrement réécrite (pas de lecture du disque)
+ */
+enum AccesTuile { TUILE_LECTURE, TUILE_ECRITURE, TUILE_NOUVELLE };
+
+/**
+ * @brief Ouvre (ou crée) le fichier des tuiles et alloue le cache
+ *
+ * @param s Magasin (sortie), à fermer avec fermerStock
+ * @param f Fichier, éventuellement partagé entre processus (régions disjointes)
+ * @param base Début de la région du magasin dans le fichier
+ * @param nb_tuiles Nombre de tuiles
+ * @param taille Octets d'une tuile
+ * @param capacite Nombre de tuiles gardées en mémoire (au moins 1)
+ * @return int 0 si succès, -1 si le fichier ne peut être ouvert
+ */
+int ouvrirStock(StockTuiles* s, const char* f, long long base, long nb_tuiles,
+                long taille, int capacite);
+
+/**
+ * @brief Adresse en mémoire de la tuile t, chargée si besoin ; valide
+ *        jusqu'à ce que capacite autres tuiles aient été demandées
+ */
+char* tuile(StockTuiles& s, long t, AccesTuile acces);
+
+/**
+ * @brief Lecture anticipée de la tuile t si elle n'est pas en mémoire
+ */
+void anticiperTuile(StockTuiles& s, long t);
+
+/**
+ * @brief Réécrit sur disque toutes les tuiles modifiées
+ */
+void viderStock(StockTuiles& s);
+
+/**
+ * @brief Vide le cache, libère les cadres et ferme le fichier
+ */
+void fermerStock(StockTuiles& s);
+
+#endif
@@ -1,9 +1,19 @@
 #include "Utils.hpp"
+#include <cstdint>
 
-void affichage (int* tab, int n, int m, int format) {
+template<typename T>
+void affichage (T* tab, int n, int m, int format) {
     for (int i=0; i<n; i++) {
-        for (int j=0; j<m; j++)
-            cout << setw(format) << tab[i*m+j] << " ";
+        for (int j=0; j<m; j++) {
+            // "∞" occupe 3 octets pour une seule colonne
+            if (tab[i*m+j] >= Poids<T>::infini()) cout << setw(format+2) << "∞" << " ";
+            else cout << setw(format) << tab[i*m+j] << " ";
+        }
         cout << endl;
     }
-}
\ No newline at end of file
+}
+
+template void affichage<int16_t>(int16_t*, int, int, int);
+template void affichage<int32_t>(int32_t*, int, int, int);
+template void affichage<int64_t>(int64_t*, int, int, int);
+template void affichage<float>(float*, int, int, int);
@@ -3,16 +3,18 @@
 
 #include <iostream>
 #include <iomanip>
+#include "Poids.hpp"
 
 using namespace std;
 /**
- * @brief Pour faciliter l'affichage
+ * @brief Pour faciliter l'affichage (∞ pour la sentinelle du type de poids)
  * 
  * @param tab représentant une matrice de taille n x m
  * @param n 
  * @param m 
  * @param format pour un affichage aligné.
  */
-void affichage (int* tab, int n, int m, int format);
+template<typename T>
+void affichage (T* tab, int n, int m, int format);
 
 #endif
\ No newline at end of file
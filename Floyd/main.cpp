@@ -5,112 +5,124 @@
 #include <map>
 #include <cmath>
 #include <iomanip>
+#include <cstdio>
+#include <cctype>
+#include <cerrno>
+#include <climits>
 #include "ForGraph.hpp"
 #include "FoydPar.hpp"
 #include "Utils.hpp"
+#include "MinPlus.hpp"
+#include "Dijkstra.hpp"
+#include "Composantes.hpp"
+#include "Ordre.hpp"
 #include <vector>
 using namespace std;
 
-int main(int argc, char* argv[]) {
-    int pid, nprocs;
-    int provided;
-    
-    // Initialisation MPI avec support multi-threading
-    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
-    MPI_Comm_rank(MPI_COMM_WORLD, &pid);
-    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
-
-    if (argc < 2 || argc > 3) {
-        if (pid == 0) {
-            cout << "Usage : mpirun -np <P> ./main fichier.dot [num_threads]" << endl;
-            cout << endl;
-            cout << "Paramètres:" << endl;
-            cout << "  <P>           : Nombre de processus MPI (carré parfait: 4, 9, 16...)" << endl;
-            cout << "  fichier.dot   : Graphe au format DOT" << endl;
-            cout << "  [num_threads] : Threads OpenMP par processus (défaut: auto)" << endl;
-            cout << endl;
-            cout << "Exemples:" << endl;
-            cout << "  mpirun -np 4 ./main Exemple2.dot" << endl;
-            cout << "  mpirun -np 4 ./main Exemple2.dot 2" << endl;
-        }
-        MPI_Finalize();
-        return EXIT_FAILURE;
+/* Cumule sur len distances : somme des distances finies et nombre de paires
+ * non reliées (acc), plus grande distance finie (diametre) */
+template<typename T>
+static void resumerDistances(const T* v, int len, long long acc[2], long long* diametre) {
+    for (int j = 0; j < len; j++) {
+        if (v[j] >= Poids<T>::infini()) acc[1]++;
+        else { acc[0] += (long long)v[j]; *diametre = max(*diametre, (long long)v[j]); }
     }
+}
 
-    char* file_name = argv[1];
-    int num_threads = 4; // Default value
-    
-    // Configuration OpenMP
-    if(num_threads > 0){
-        omp_set_num_threads(num_threads);
-    }
+/* CSR du moteur creux lu directement depuis un fichier .gcsr (faux sinon) */
+static bool csrDepuisFichier(const char* f, GrapheCSR* g) {
+    VueCSR vue;
+    if (!estFichierCSR(f) || ouvrirCSR(f, &vue) != 0) return false;
+    *g = csrDepuisVue(vue);
+    fermerCSR(vue);
+    return true;
+}
 
-    int nb_nodes = 0;
+/* Options de la ligne de commande et graphe lu sur le root */
+struct Execution {
+    int pid, nprocs;
+    int num_threads;
+    bool anticipation, distribue;
+    string chemin_de, chemin_vers;   // --chemin : requête de plus court chemin
+    string semi_anneau;              // min-plus, max-min ou booleen
+    vector<string> ajouts;           // --ajout : triplets (A, B, poids) insérés après le calcul
+    string point_reprise;            // --point-reprise : fichier des points de reprise
+    int intervalle_reprise;          // étapes K entre deux points
+    bool reprendre;                  // --reprendre : repartir du dernier point
+    string hors_memoire;             // --hors-memoire : fichier des blocs
+    long long memoire;               // octets de blocs en mémoire par processus
+    bool silencieux;                 // --silencieux : ni matrices ni référence séquentielle
+    string sortie;                   // --sortie : matrice résultat binaire (MPI-IO)
+    bool profil;                     // --profil : temps des phases par processus
+    bool flux;                       // --flux : tâches par bloc, messages point à point
+    int couches;                     // --couches : fermeture 2.5D à c copies (0 : grille 2D)
+    bool symetrique;                 // --symetrique : triangle supérieur de blocs seulement
+    bool composantes;                // --composantes : APSP par composante connexe
+    string ordre;                    // --ordre : renumérotation rcm ou medoides (vide : aucune)
+    vector<int> permutation;         // root : le sommet d'origine permutation[i] devient i
+    string profil_rangs;             // --profil-rangs : CSV par processus et par étape
+    int nb, pr, pc;                  // 0 = choix automatique
+    int nb_nodes;
     map<string,int> my_nodes;
-    int* D = nullptr;
+    int* mat_adjacence;              // root, sauf en mode distribué
+    vector<int> aretes;              // root, mode distribué
+    GrapheCSR csr;                   // moteur creux
+    int creux;
+};
 
-    if (pid == 0) {
-        cout << "╔═══════════════════════════════════════════════════════════╗" << endl;
-        cout << "║     FLOYD-WARSHALL HYBRIDE MPI+OPENMP                     ║" << endl;
-        cout << "╚═══════════════════════════════════════════════════════════╝" << endl;
-        cout << endl;
-        cout << "Configuration:" << endl;
-        cout << "  Fichier       : " << file_name << endl;
-        cout << "  Processus MPI : " << nprocs << endl;
-        cout << "  Threads/proc  : " << (num_threads > 0 ? to_string(num_threads) : "auto") 
-             << " (max: " << omp_get_max_threads() << ")" << endl;
-        cout << "  Total workers : " << nprocs * omp_get_max_threads() << endl;
-        cout << "  Niveau thread : " << provided;
-        if(provided >= MPI_THREAD_FUNNELED) cout << " ✓";
-        cout << endl << endl;
-    }
+/* Calcul (séquentiel de référence puis hybride) avec des poids de type T ;
+ * le moteur creux travaille toujours sur des int */
+template<typename T>
+static void calculer(Execution& e) {
+    int pid = e.pid, nprocs = e.nprocs, nb_nodes = e.nb_nodes;
+    int num_threads = e.num_threads;
+    bool anticipation = e.anticipation, distribue = e.distribue;
+    int creux = e.creux;
+    vector<int>& aretes = e.aretes;
+    GrapheCSR& csr = e.csr;
+    map<string,int>& my_nodes = e.my_nodes;
+    bool min_plus = (e.semi_anneau == "min-plus");
+    // Matrice n x n rassemblée sur le root pour l'affichage ; sinon le
+    // résultat reste distribué (résumé, --sortie)
+    bool rassembler = !distribue && !e.silencieux;
+    T* D = nullptr;
 
-    // Lecture du graphe sur le root
-    if (pid == 0) {
-        int* mat_adjacence = lectureGraphe(file_name, &nb_nodes, &my_nodes);
-        if (!mat_adjacence) {
-            cerr << "Erreur : impossible de lire le graphe !" << endl;
-            MPI_Abort(MPI_COMM_WORLD, 1);
+    if (pid == 0 && e.mat_adjacence) {
+        D = InitDk<T>(nb_nodes, e.mat_adjacence);
+        delete[] e.mat_adjacence;
+        e.mat_adjacence = nullptr;
+        if (!e.silencieux) {
+            cout << "=== Matrice de distances initiale ===" << endl;
+            affichage(D, nb_nodes, nb_nodes, 3);
+            cout << endl;
         }
-
-        cout << "=== Matrice d'adjacence ===" << endl;
-        affichage(mat_adjacence, nb_nodes, nb_nodes, 2);
-        cout << endl;
-
-        D = InitDk(nb_nodes, mat_adjacence);
-        delete[] mat_adjacence;
-
-        cout << "=== Matrice de distances initiale ===" << endl;
-        affichage(D, nb_nodes, nb_nodes, 3);
-        cout << endl;
     }
 
-    // Diffusion du nombre de noeuds à tous les processus
-    MPI_Bcast(&nb_nodes, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-    // Vérification du nombre de processus carré parfait
-    int p_sqrt = (int)sqrt(nprocs);
-    if (p_sqrt * p_sqrt != nprocs || nb_nodes % p_sqrt != 0) {
-        if (pid == 0) {
-            cerr << "Erreur : nprocs=" << nprocs << " pas carré parfait" << endl;
-            cerr << "   ou nb_nodes=" << nb_nodes << " non divisible par √P=" << p_sqrt << endl;
-        }
-        MPI_Finalize();
-        return -1;
+    // Distribution 2D bloc-cyclique : P et n quelconques
+    Distribution dist = creerDistribution(nb_nodes, e.nb, e.pr, e.pc);
+    bool hors_memoire = !e.hors_memoire.empty();
+    bool composantes = e.composantes;
+    // Mode symétrique : blocs (I <= J) seulement, dans un tableau de taille réduite
+    Triangle triangle;
+    const Triangle* tri = nullptr;
+    if (e.symetrique && !creux) {
+        triangle = creerTriangle(dist);
+        tri = &triangle;
     }
-
-    int block_size = nb_nodes / p_sqrt;
-    int* D_local = new int[block_size * block_size];
+    T* D_local = (creux || hors_memoire || composantes) ? nullptr
+               : new T[tri ? tailleTriangle(dist, *tri) : tailleLocale(dist)];
 
     // ----- CALCUL SEQUENTIEL -----
     double t_seq_start = 0, t_seq_end = 0;
-    if (pid == 0) {
+    if (pid == 0 && rassembler && min_plus) {
         cout << "┌─────────────────────────────────────────────────────────┐" << endl;
         cout << "│ CALCUL SÉQUENTIEL (référence)                          │" << endl;
         cout << "└─────────────────────────────────────────────────────────┘" << endl;
         
         t_seq_start = MPI_Wtime();
-        int* D_seq = MatDistance(nb_nodes, D);
+        T* D_seq = new T[(long)nb_nodes * nb_nodes];
+        copy(D, D + (long)nb_nodes * nb_nodes, D_seq);
+        floydTuiles(D_seq, nb_nodes, nullptr, FLOYD_TUILE);
         t_seq_end = MPI_Wtime();
 
         cout << "=== Matrice de distances (séquentiel) ===" << endl;
@@ -120,24 +132,176 @@ int main(int argc, char* argv[]) {
         cout << "\n✓ Temps séquentiel : " << (t_seq_end - t_seq_start) << " sec" << endl;
         cout << endl;
     }
-
     // ----- CALCUL PARALLELE HYBRIDE -----
     if (pid == 0) {
         cout << "┌─────────────────────────────────────────────────────────┐" << endl;
         cout << "│ CALCUL HYBRIDE MPI+OPENMP                               │" << endl;
         cout << "└─────────────────────────────────────────────────────────┘" << endl;
-        cout << "  Grille        : " << p_sqrt << " × " << p_sqrt << " processus" << endl;
-        cout << "  Taille bloc   : " << block_size << " × " << block_size << endl;
-        cout << "  Mode          : Hybride (MPI + OpenMP)" << endl;
+        if (composantes) {
+            cout << "  Moteur        : dense par composante connexe (grandes sur la grille "
+                 << dist.g.pr << " × " << dist.g.pc << ", petites regroupées)" << endl;
+        } else if (creux) {
+            cout << "  Moteur        : creux (Dijkstra multi-sources, tas radix)" << endl;
+            cout << "  Densité       : " << (double)csr.voisins.size() / ((double)nb_nodes * nb_nodes)
+                 << " (seuil " << FLOYD_DENSITE_CREUX << ")" << endl;
+        } else {
+            cout << "  Grille        : " << dist.g.pr << " × " << dist.g.pc << " processus" << endl;
+            cout << "  Taille bloc   : " << dist.nb << " × " << dist.nb
+                 << " (" << dist.nblocs << " × " << dist.nblocs << " blocs, bloc-cyclique"
+                 << (tri ? ", " + to_string((long)dist.nblocs * (dist.nblocs + 1) / 2)
+                           + " stockés (triangle supérieur)" : "") << ")" << endl;
+        }
+        cout << "  Mode          : Hybride (MPI + OpenMP)"
+             << (hors_memoire ? " hors mémoire" : e.flux && !creux ? " par flot de données"
+                 : e.couches && !creux ? " 2.5D (" + to_string(e.couches) + " couches de "
+                                         + to_string(nprocs / e.couches) + " processus)"
+                 : tri ? " symétrique"
+                 : anticipation && !creux ? " avec anticipation" : "") << endl;
+        if (!min_plus)
+            cout << "  Semi-anneau   : " << e.semi_anneau << endl;
         cout << endl;
     }
     
-    decouperMatrice(D, D_local, nb_nodes, block_size, p_sqrt, 0, pid);
+    // Renumérotation sur le root avant la distribution des blocs : les
+    // sorties sont remises dans la numérotation d'origine avant affichage
+    if (pid == 0 && !creux && !e.ordre.empty()) {
+        double t_ordre = MPI_Wtime();
+        e.permutation = (e.ordre == "rcm") ? ordreCuthillMcKee(csr) : ordreMedoides(csr, dist.nblocs);
+        GrapheCSR h = permuterCSR(csr, e.permutation);
+        vector<int> place(nb_nodes);
+        for (int i = 0; i < nb_nodes; i++) place[e.permutation[i]] = i;
+        if (D) {
+            T* P = permuterMatrice(D, nb_nodes, e.permutation, false);
+            delete[] D;
+            D = P;
+        }
+        for (size_t a = 0; a + 2 < aretes.size(); a += 3) {
+            aretes[a] = place[aretes[a]];
+            aretes[a+1] = place[aretes[a+1]];
+        }
+        for (auto& x : my_nodes) x.second = place[x.second];
+        t_ordre = MPI_Wtime() - t_ordre;
+        int largeur[2];
+        double moyenne[2];
+        largeurBande(csr, &largeur[0], &moyenne[0]);
+        largeurBande(h, &largeur[1], &moyenne[1]);
+        csr = h;
+        cout << "=== Renumérotation " << e.ordre << " en " << t_ordre << " sec : largeur de bande "
+             << largeur[0] << " -> " << largeur[1] << ", écart moyen à la diagonale "
+             << moyenne[0] << " -> " << moyenne[1] << " ===" << endl << endl;
+    }
+
+    if (creux) {
+        diffuserCSR(csr, 0, MPI_COMM_WORLD);
+        vector<int>().swap(aretes);
+        delete[] D;
+        D = nullptr;
+    } else if (composantes) {
+        // Les composantes sont extraites du CSR du root
+        vector<int>().swap(aretes);
+        delete[] D;
+        D = nullptr;
+    } else if (distribue && !hors_memoire) {
+        distribuerAretes(aretes.data(), (long)aretes.size()/3, D_local, dist, 0, tri);
+        vector<int>().swap(aretes);
+    } else if (!hors_memoire) {
+        decouperMatrice(D, D_local, dist, 0, tri);
+        // D n'est plus utile : le root ne garde qu'une matrice n x n à la fois
+        delete[] D;
+        D = nullptr;
+    }
+
+    // Successeurs distribués, mis à jour avec D_local
+    int* N_local = nullptr;
+    if (!e.chemin_de.empty() && !creux) {
+        N_local = new int[tailleLocale(dist)];
+        initialiserSuivants(D_local, N_local, dist);
+    }
+
+    PointReprise reprise = {e.point_reprise.c_str(), e.intervalle_reprise, e.reprendre, 0, 0, 0, 0, 0};
+    PointReprise* rep = (e.point_reprise.empty() || creux) ? nullptr : &reprise;
+    TempsPhases temps{};
+    temps.synchroniser = true;
+    temps.par_etape = !e.profil_rangs.empty();
+    TempsPhases* prof = (e.profil && !creux && !hors_memoire) ? &temps : nullptr;
 
     MPI_Barrier(MPI_COMM_WORLD);
     double t0 = MPI_Wtime();
+
+    // Décomposition en composantes connexes sur le root, comptée dans le temps parallèle
+    Decomposition dec;
+    dec.nb_composantes = 0;
+    BilanComposantes bilan;
+    ResumeDistances resume_composantes = {0, 0, 0};
+    double t_decomposition = 0;
+    if (composantes && pid == 0) {
+        t_decomposition = MPI_Wtime();
+        dec = decomposerComposantes(csr);
+        t_decomposition = MPI_Wtime() - t_decomposition;
+    }
     
-    int* D_final = floydBlocsHybrid(D_local, nb_nodes, p_sqrt, pid, 0, num_threads);
+    HorsMemoire hm;
+    hm.fichier = e.hors_memoire.c_str();
+    hm.memoire = e.memoire;
+    T* D_final = nullptr;
+    int* D_creux = nullptr;
+    int* D_acces = nullptr;
+    int* A_local = nullptr;
+    int* lignes = nullptr;
+    int premiere = 0, nb_lignes = 0;
+    if (composantes)
+        D_final = apspComposantes<T>(dec, csr, e.nb, e.pr, e.pc, 0, num_threads, rassembler,
+                                     &resume_composantes, &bilan);
+    else if (creux && !rassembler) {
+        trancheSources(nb_nodes, pid, nprocs, &premiere, &nb_lignes);
+        lignes = apspCreuxLignes(csr, premiere, nb_lignes);
+    } else if (creux)
+        D_creux = apspCreux(csr, 0, num_threads, MPI_COMM_WORLD);
+    else if (hors_memoire) {
+        // Blocs construits dans le fichier depuis les arêtes du root
+        if (floydHorsMemoire<T>(aretes.data(), (long)aretes.size()/3, dist, 0, num_threads, &hm) != 0) {
+            if (pid == 0) cerr << "Erreur : impossible de créer " << e.hors_memoire << endl;
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        vector<int>().swap(aretes);
+    } else if (e.semi_anneau == "max-min") {
+        largeursDepuisDistances(D_local, dist, tri);
+        if (e.flux)
+            fermetureFluxLocal<MaxMin<T> >(D_local, dist, num_threads, FLOYD_FENETRE_FLUX, prof);
+        else if (e.couches)
+            fermetureCouchesLocal<MaxMin<T> >(D_local, dist, e.couches, num_threads, prof);
+        else if (tri)
+            fermetureSymetriqueLocal<MaxMin<T> >(D_local, dist, *tri, num_threads, prof);
+        else
+            fermetureBlocsLocal<MaxMin<T> >(D_local, dist, num_threads, anticipation, nullptr, rep, prof);
+        if (rassembler) D_final = rassemblerMatrice(D_local, dist, 0, tri);
+    } else if (e.semi_anneau == "booleen") {
+        // Blocs compactés à 64 sommets par mot, dépliés en 0/1 pour le
+        // rassemblement ou l'écriture
+        uint64_t* R_local = compacterAccessibilite(D_local, dist);
+        if (e.flux)
+            fermetureFluxLocal<Accessibilite>(R_local, dist, num_threads, FLOYD_FENETRE_FLUX, prof);
+        else if (e.couches)
+            fermetureCouchesLocal<Accessibilite>(R_local, dist, e.couches, num_threads, prof);
+        else
+            fermetureBlocsLocal<Accessibilite>(R_local, dist, num_threads, anticipation, nullptr, rep, prof);
+        A_local = new int[tailleLocale(dist)];
+        deplierAccessibilite(R_local, dist, A_local);
+        if (rassembler) D_acces = rassemblerMatrice(A_local, dist, 0);
+        delete[] R_local;
+    } else if (e.flux) {
+        fermetureFluxLocal<MinPlus<T> >(D_local, dist, num_threads, FLOYD_FENETRE_FLUX, prof);
+        if (rassembler) D_final = rassemblerMatrice(D_local, dist, 0);
+    } else if (e.couches) {
+        fermetureCouchesLocal<MinPlus<T> >(D_local, dist, e.couches, num_threads, prof);
+        if (rassembler) D_final = rassemblerMatrice(D_local, dist, 0);
+    } else if (tri) {
+        fermetureSymetriqueLocal<MinPlus<T> >(D_local, dist, *tri, num_threads, prof);
+        if (rassembler) D_final = rassemblerMatrice(D_local, dist, 0, tri);
+    } else if (!rassembler)
+        floydBlocsLocal(D_local, dist, num_threads, anticipation, N_local, rep, prof);
+    else
+        D_final = floydBlocsHybrid(D_local, dist, 0, num_threads, anticipation, N_local, rep, prof);
     
     MPI_Barrier(MPI_COMM_WORLD);
     double t1 = MPI_Wtime();
@@ -145,9 +309,230 @@ int main(int argc, char* argv[]) {
     double local_time = t1 - t0, max_time;
     MPI_Reduce(&local_time, &max_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
 
-    if (pid == 0) {
-        cout << "=== Matrice globale après Floyd par blocs Hybride (MPI+OpenMP) ===" << endl;
-        affichage(D_final, nb_nodes, nb_nodes, 3);
+    if (composantes && pid == 0) {
+        int k = dec.nb_composantes;
+        cout << "=== Composantes connexes : " << k << " (plus grande : "
+             << (k ? dec.debut[1] : 0) << " noeuds), trouvées en " << t_decomposition << " sec ===" << endl;
+        cout << "  Sur la grille : " << bilan.sur_grille << " (>= " << FLOYD_COMPOSANTE_GRILLE
+             << " noeuds), regroupées : " << bilan.regroupees << endl;
+        cout << "  Travail       : " << 100 * bilan.travail << " % de celui de Floyd sur tout le graphe"
+             << endl << endl;
+    }
+
+    if (rep) {
+        // Coût des points de reprise face au temps d'une étape K, pour régler l'intervalle
+        double temps[2] = {rep->temps_ecriture, rep->temps_lecture}, temps_max[2];
+        MPI_Reduce(temps, temps_max, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        int etapes = dist.nblocs - rep->k_depart;
+        if (pid == 0) {
+            cout << "=== Points de reprise (" << e.point_reprise << ") ===" << endl;
+            if (rep->reprendre)
+                cout << "  Reprise à l'étape : " << rep->k_depart << " / " << dist.nblocs
+                     << " (relu en " << temps_max[1] << " sec)" << endl;
+            if (rep->intervalle > 0)
+                cout << "  Points écrits     : " << rep->ecritures << " (toutes les "
+                     << rep->intervalle << " étapes, " << rep->octets / 1e6 << " Mo chacun)" << endl;
+            if (rep->ecritures > 0)
+                cout << "  Coût d'un point   : " << temps_max[0] / rep->ecritures << " sec ("
+                     << temps_max[0] << " sec au total)" << endl;
+            if (etapes > 0)
+                cout << "  Temps d'une étape : " << (max_time - temps_max[0] - temps_max[1]) / etapes
+                     << " sec (" << etapes << " étapes calculées)" << endl;
+            cout << endl;
+        }
+    }
+
+    if (prof) {
+        // Temps des phases sur les processus : choix de la grille et des threads
+        StatistiquesPhase stats[NB_PHASES + 1];
+        reduireTempsPhases(temps, stats, MPI_COMM_WORLD, 0);
+        long sauts[3] = {temps.bandes_calculees, temps.bandes_sautees, temps.blocs_non_diffuses};
+        long sauts_tot[3];
+        MPI_Reduce(sauts, sauts_tot, 3, MPI_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+        if (pid == 0) {
+            const char* noms[NB_PHASES + 1] = {"panneaux", "diffusion", "reste", "attente", "total"};
+            cout << "=== Profil des phases (sec, " << nprocs << " processus, grille " << dist.g.pr
+                 << " × " << dist.g.pc << ", " << num_threads << " threads) ===" << endl;
+            cout << "  phase          min     moyenne         max   déséquilibre" << endl;
+            for (int p = 0; p <= NB_PHASES; p++)
+                cout << "  " << left << setw(10) << noms[p] << right << fixed << setprecision(5)
+                     << setw(11) << stats[p].min << setw(12) << stats[p].moyenne << setw(12) << stats[p].max
+                     << setprecision(1) << setw(13) << 100 * stats[p].desequilibre << " %" << endl;
+            cout.unsetf(ios::floatfield);
+            cout << setprecision(6);
+            if (anticipation)
+                cout << "  (anticipation : attentes comptées dans la diffusion)" << endl;
+            if (FLOYD_SAUT_TUILES && !e.flux && !e.couches && !tri) {
+                long bandes = sauts_tot[0] + sauts_tot[1];
+                cout << "  Bandes de la phase 5 sautées : " << sauts_tot[1] << " sur " << bandes;
+                if (bandes > 0)
+                    cout << " (" << setprecision(1) << fixed << 100.0 * sauts_tot[1] / bandes << " %)";
+                cout.unsetf(ios::floatfield);
+                cout << setprecision(6) << ", blocs vides non diffusés : " << sauts_tot[2] << endl;
+            }
+        }
+        if (!e.profil_rangs.empty()) {
+            if (ecrireTempsRangs(e.profil_rangs.c_str(), temps, dist.g, 0) == 0) {
+                if (pid == 0)
+                    cout << "  Détail par processus et par étape : " << e.profil_rangs << endl;
+            } else if (pid == 0)
+                cerr << "Erreur : impossible d'écrire " << e.profil_rangs << endl;
+        }
+        if (pid == 0) cout << endl;
+    }
+
+    if (!e.ajouts.empty()) {
+        // Mise à jour incrémentale des blocs fermés, arête par arête ; un nom
+        // inconnu crée un nouveau sommet (ajouterSommet)
+        double t_inc = MPI_Wtime();
+        for (size_t a = 0; a < e.ajouts.size(); a += 3) {
+            int arete[4] = {-1, -1, stoi(e.ajouts[a+2]), 0}; // u, v, poids, nouveau sommet
+            if (pid == 0) {
+                for (int x = 0; x < 2; x++) {
+                    const string& nom = e.ajouts[a+x];
+                    if (!my_nodes.count(nom) && !arete[3] && e.ajouts[a] != e.ajouts[a+1]) {
+                        my_nodes[nom] = dist.n;
+                        arete[3] = 1;
+                    }
+                    if (my_nodes.count(nom)) arete[x] = my_nodes[nom];
+                }
+            }
+            MPI_Bcast(arete, 4, MPI_INT, 0, MPI_COMM_WORLD);
+            if (arete[0] < 0 || arete[1] < 0) {
+                if (pid == 0) {
+                    cerr << "Arête ignorée : " << e.ajouts[a] << " -- " << e.ajouts[a+1] << endl;
+                    // Le sommet créé pour cette arête n'existe pas
+                    for (int x = 0; x < 2 && arete[3]; x++)
+                        if (arete[x] == dist.n) my_nodes.erase(e.ajouts[a+x]);
+                }
+            } else {
+                // Les graphes lus sont non orientés : l'arête est insérée
+                // dans les deux sens (u -> v puis v -> u)
+                int sens[6] = {arete[0], arete[1], arete[2], arete[1], arete[0], arete[2]};
+                if (arete[3])
+                    ajouterSommet(&D_local, &dist, sens, 2, &N_local);
+                else
+                    insererAretes(D_local, dist, sens, 2, N_local);
+            }
+        }
+        t_inc = MPI_Wtime() - t_inc;
+        nb_nodes = dist.n;
+        if (D_final) {
+            delete[] D_final;
+            D_final = nullptr;
+        }
+        if (rassembler)
+            D_final = rassemblerMatrice(D_local, dist, 0);
+        if (pid == 0)
+            cout << "✓ Mise à jour incrémentale : " << e.ajouts.size()/3 << " arête(s), "
+                 << nb_nodes << " noeuds, " << t_inc << " sec" << endl << endl;
+    }
+
+    if (hors_memoire) {
+        // Volume d'E/S du magasin de blocs (max sur les processus)
+        double v[4] = {(double)hm.stock.lus, (double)hm.stock.ecrits, hm.stock.temps,
+                       hm.temps_construction}, v_max[4];
+        MPI_Reduce(v, v_max, 4, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (pid == 0) {
+            long long bloc = (long long)dist.nb * dist.nb * sizeof(T);
+            cout << "=== Hors mémoire (" << e.hors_memoire << ") ===" << endl;
+            cout << "  Cache par processus : " << hm.stock.capacite << " blocs de " << dist.nb
+                 << " x " << dist.nb << " (" << hm.stock.capacite * bloc / 1e6 << " Mo sur "
+                 << (long long)dist.lignes * dist.colonnes * bloc / 1e6 << " Mo locaux)" << endl;
+            cout << "  Construction        : " << v_max[3] << " sec" << endl;
+            cout << "  Lu / écrit (max)    : " << v_max[0] / 1e6 << " / " << v_max[1] / 1e6
+                 << " Mo en " << v_max[2] << " sec d'E/S" << endl << endl;
+        }
+    }
+
+    if (!e.sortie.empty()) {
+        // Écriture collective depuis les blocs ou les lignes de chaque processus
+        double t_ecriture = MPI_Wtime();
+        int r;
+        if (lignes || creux)
+            r = ecrireResultatLignes(e.sortie.c_str(), lignes ? lignes : D_creux, premiere,
+                                     lignes ? nb_lignes : (pid == 0 ? nb_nodes : 0), nb_nodes, MPI_COMM_WORLD);
+        else if (hors_memoire)
+            r = ecrireResultatHorsMemoire<T>(e.sortie.c_str(), &hm, dist);
+        else if (A_local)
+            r = ecrireResultat(e.sortie.c_str(), A_local, dist);
+        else
+            r = ecrireResultat(e.sortie.c_str(), D_local, dist);
+        t_ecriture = MPI_Wtime() - t_ecriture;
+        if (pid == 0) {
+            if (r == 0)
+                cout << "=== Résultat écrit dans " << e.sortie << " (" << nb_nodes << " x " << nb_nodes
+                     << ", " << (lignes || creux || A_local ? sizeof(int) : sizeof(T)) << " octets par valeur, "
+                     << t_ecriture << " sec) ===" << endl << endl;
+            else
+                cerr << "Erreur : impossible d'écrire " << e.sortie << endl;
+        }
+    }
+
+    if (!rassembler && min_plus) {
+        // Résumé calculé sur les données locales : la matrice n'est jamais rassemblée
+        long long local[2] = {0, 0}, total[2]; // somme des distances, paires non reliées
+        long long local_max = 0, diametre;
+        if (composantes) {
+            local[0] = resume_composantes.somme;
+            local[1] = resume_composantes.non_reliees;
+            local_max = resume_composantes.diametre;
+        }
+        for (int s = 0; s < nb_lignes; s++)
+            resumerDistances(lignes + (long)s * nb_nodes, nb_nodes, local, &local_max);
+        for (int li = 0; li < dist.lignes && !creux && !composantes; li++)
+            for (int lj = 0; lj < dist.colonnes; lj++) {
+                int i0 = blocGlobalLigne(dist, li) * dist.nb, j0 = blocGlobalColonne(dist, lj) * dist.nb;
+                const T* B = hors_memoire ? (const T*)tuile(hm.stock, (long)li * dist.colonnes + lj, TUILE_LECTURE)
+                           : tri ? blocTriangle(D_local, dist, *tri, li, lj)
+                                 : blocLocal(D_local, dist, li, lj);
+                if (!B) continue;
+                // Mode symétrique : un bloc hors diagonale compte aussi pour sa transposée
+                long long bloc[2] = {0, 0};
+                for (int i = 0; i < dist.nb && i0+i < nb_nodes; i++)
+                    resumerDistances(B + i*dist.nb, min(dist.nb, nb_nodes - j0), bloc, &local_max);
+                int fois = (tri && i0 != j0) ? 2 : 1;
+                local[0] += fois * bloc[0];
+                local[1] += fois * bloc[1];
+            }
+        MPI_Reduce(local, total, 2, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&local_max, &diametre, 1, MPI_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (pid == 0) {
+            cout << "=== Résumé des distances (" << (distribue ? "mode distribué" : "silencieux") << ") ===" << endl;
+            cout << "  Somme des distances : " << total[0] << endl;
+            cout << "  Paires non reliées  : " << total[1] << endl;
+            cout << "  Diamètre            : " << diametre << endl;
+        }
+    }
+
+    if (pid == 0 && !e.permutation.empty()) {
+        // Retour à la numérotation d'origine (les sommets ajoutés restent à la fin)
+        if (D_final) {
+            T* R = permuterMatrice(D_final, nb_nodes, e.permutation, true);
+            delete[] D_final;
+            D_final = R;
+        }
+        if (D_acces) {
+            int* R = permuterMatrice(D_acces, nb_nodes, e.permutation, true);
+            delete[] D_acces;
+            D_acces = R;
+        }
+    }
+
+    if (pid == 0 && (D_final || D_creux || D_acces)) {
+        if (creux) {
+            cout << "=== Matrice globale après Dijkstra multi-sources (MPI+OpenMP) ===" << endl;
+            affichage(D_creux, nb_nodes, nb_nodes, 3);
+        } else if (D_acces) {
+            cout << "=== Fermeture transitive (accessibilité, MPI+OpenMP) ===" << endl;
+            affichage(D_acces, nb_nodes, nb_nodes, 1);
+        } else if (!min_plus) {
+            cout << "=== Largeurs de goulot (max,min) (0 = aucun chemin, MPI+OpenMP) ===" << endl;
+            affichage(D_final, nb_nodes, nb_nodes, 3);
+        } else {
+            cout << "=== Matrice globale après Floyd par blocs Hybride (MPI+OpenMP) ===" << endl;
+            affichage(D_final, nb_nodes, nb_nodes, 3);
+        }
 
         cout << "\n✓ Temps parallèle : " << max_time << " sec" << endl;
         cout << endl;
@@ -172,10 +557,440 @@ int main(int argc, char* argv[]) {
         }
 
         delete[] D_final;
-        delete[] D;
+        delete[] D_creux;
+        delete[] D_acces;
+    }
+    if (pid == 0 && !rassembler)
+        cout << "\n✓ Temps parallèle : " << max_time << " sec" << endl;
+
+    if (N_local) {
+        // Requête de chemin sur les successeurs distribués (sans rassemblement)
+        int ij[2] = {-1, -1};
+        vector<string> noms;
+        if (pid == 0) {
+            noms.resize(nb_nodes);
+            for (auto& x : my_nodes) noms[x.second] = x.first;
+            if (my_nodes.count(e.chemin_de)) ij[0] = my_nodes[e.chemin_de];
+            if (my_nodes.count(e.chemin_vers)) ij[1] = my_nodes[e.chemin_vers];
+        }
+        MPI_Bcast(ij, 2, MPI_INT, 0, MPI_COMM_WORLD);
+        vector<int> route;
+        if (ij[0] >= 0 && ij[1] >= 0)
+            route = cheminDistribue(N_local, dist, ij[0], ij[1]);
+        if (pid == 0) {
+            cout << "\n=== Plus court chemin " << e.chemin_de << " -> " << e.chemin_vers << " ===" << endl;
+            if (ij[0] < 0 || ij[1] < 0)
+                cout << "  Sommet inconnu" << endl;
+            else if (route.empty())
+                cout << "  Aucun chemin" << endl;
+            else {
+                cout << " ";
+                for (size_t q = 0; q < route.size(); q++)
+                    cout << (q ? " → " : " ") << noms[route[q]];
+                cout << "  (" << route.size() - 1 << " arêtes)" << endl;
+            }
+        }
     }
 
+    if (hors_memoire)
+        fermerStock(hm.stock);
+    delete[] lignes;
+    delete[] A_local;
+    delete[] N_local;
     delete[] D_local;
+    libererDistribution(dist);
+}
+
+int main(int argc, char* argv[]) {
+    int pid, nprocs;
+    int provided;
+    
+    // Initialisation MPI avec support multi-threading
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    char* file_name = (argc >= 2) ? argv[1] : nullptr;
+    int num_threads = 4; // Default value
+    bool anticipation = false;
+    bool distribue = false;
+    string moteur = "auto";
+    string poids = "auto";
+    string chemin_de, chemin_vers; // --chemin : requête de plus court chemin
+    string semi_anneau = "min-plus";
+    vector<string> ajouts;
+    string ecrire_csr;             // --ecrire-csr : conversion au format binaire
+    string point_reprise;          // --point-reprise F N
+    int intervalle_reprise = 0;
+    bool reprendre = false;
+    string hors_memoire;           // --hors-memoire F MO
+    long long memoire = 0;
+    bool silencieux = false;
+    string sortie;                 // --sortie F : résultat binaire
+    bool profil = false;
+    bool flux = false;
+    int couches = 0;               // --couches C : facteur de réplication 2.5D
+    bool symetrique = false;
+    bool composantes = false;
+    string ordre;                  // --ordre rcm|medoides
+    string profil_rangs;           // --profil-rangs F : CSV par processus
+    int nb = 0, pr = 0, pc = 0; // 0 = choix automatique
+    bool args_ok = (argc >= 2);
+    for (int a = 2; a < argc && args_ok; a++) {
+        string arg = argv[a];
+        if (arg == "--anticipation")
+            anticipation = true;
+        else if (arg == "--distribue")
+            distribue = true;
+        else if (arg == "--moteur" && a+1 < argc) {
+            moteur = argv[++a];
+            args_ok = (moteur == "auto" || moteur == "dense" || moteur == "creux");
+        }
+        else if (arg == "--poids" && a+1 < argc) {
+            poids = argv[++a];
+            args_ok = (poids == "auto" || poids == "int16" || poids == "int32"
+                       || poids == "int64" || poids == "float");
+        }
+        else if (arg == "--semi-anneau" && a+1 < argc) {
+            semi_anneau = argv[++a];
+            args_ok = (semi_anneau == "min-plus" || semi_anneau == "max-min"
+                       || semi_anneau == "booleen");
+        }
+        else if (arg == "--ajout" && a+3 < argc) {
+            for (int x = 1; x <= 3; x++) ajouts.push_back(argv[a+x]);
+            // Poids entier > 0 (0 signifie « pas d'arête »), tenant dans un int
+            char* fin;
+            errno = 0;
+            long w = strtol(argv[a+3], &fin, 10);
+            args_ok = errno == 0 && fin != argv[a+3] && *fin == '\0' && w > 0 && w <= INT_MAX;
+            a += 3;
+        }
+        else if (arg == "--ecrire-csr" && a+1 < argc)
+            ecrire_csr = argv[++a];
+        else if (arg == "--point-reprise" && a+2 < argc) {
+            point_reprise = argv[++a];
+            args_ok = isdigit(argv[a+1][0]);
+            intervalle_reprise = atoi(argv[++a]);
+        }
+        else if (arg == "--reprendre")
+            reprendre = true;
+        else if (arg == "--silencieux")
+            silencieux = true;
+        else if (arg == "--sortie" && a+1 < argc)
+            sortie = argv[++a];
+        else if (arg == "--profil")
+            profil = true;
+        else if (arg == "--flux")
+            flux = true;
+        else if (arg == "--couches" && a+1 < argc) {
+            args_ok = isdigit(argv[a+1][0]);
+            couches = atoi(argv[++a]);
+            args_ok = args_ok && couches >= 1 && nprocs % couches == 0;
+        }
+        else if (arg == "--symetrique")
+            symetrique = true;
+        else if (arg == "--composantes")
+            composantes = true;
+        else if (arg == "--ordre" && a+1 < argc) {
+            ordre = argv[++a];
+            args_ok = (ordre == "rcm" || ordre == "medoides");
+        }
+        else if (arg == "--profil-rangs" && a+1 < argc) {
+            profil_rangs = argv[++a];
+            profil = true;
+        }
+        else if (arg == "--hors-memoire" && a+2 < argc) {
+            hors_memoire = argv[++a];
+            args_ok = isdigit(argv[a+1][0]);
+            memoire = atoll(argv[++a]) * 1000000LL;
+            distribue = true;
+        }
+        else if (arg == "--chemin" && a+2 < argc) {
+            chemin_de = argv[++a];
+            chemin_vers = argv[++a];
+        }
+        else if (arg == "--bloc" && a+1 < argc)
+            nb = stoi(argv[++a]);
+        else if (arg == "--grille" && a+1 < argc)
+            args_ok = (sscanf(argv[++a], "%dx%d", &pr, &pc) == 2 && pr*pc == nprocs);
+        else if (isdigit(arg[0]))
+            num_threads = stoi(arg);
+        else
+            args_ok = false;
+    }
+    // Les autres semi-anneaux passent par le moteur dense rassemblé
+    if (semi_anneau != "min-plus" && (distribue || !chemin_de.empty() || !ajouts.empty()))
+        args_ok = false;
+    if (reprendre && point_reprise.empty())
+        args_ok = false;
+    // Hors mémoire : (min,+) seul, sans successeurs, ajouts, points de reprise ni profil
+    if (!hors_memoire.empty() && (!chemin_de.empty() || !ajouts.empty() || !point_reprise.empty() || profil))
+        args_ok = false;
+    // Flot de données : sans successeurs, anticipation (implicite) ni points de reprise
+    if (flux && (!chemin_de.empty() || anticipation || !point_reprise.empty() || !hors_memoire.empty()))
+        args_ok = false;
+    // Composantes : (min,+) en mémoire, sans successeurs, ajouts, points de
+    // reprise, profil ni écriture du résultat
+    if (composantes && (semi_anneau != "min-plus" || !chemin_de.empty() || !ajouts.empty()
+                        || !point_reprise.empty() || !hors_memoire.empty() || profil || flux
+                        || !sortie.empty()))
+        args_ok = false;
+    // 2.5D : sans successeurs, anticipation, points de reprise ni autre moteur
+    if (couches && (!chemin_de.empty() || anticipation || !point_reprise.empty()
+                    || !hors_memoire.empty() || flux || composantes))
+        args_ok = false;
+    // Symétrique : (min,+) ou (max,min) sur le triangle supérieur, sans
+    // successeurs, ajouts, points de reprise, autre moteur ni écriture du résultat
+    if (symetrique && (semi_anneau == "booleen" || !chemin_de.empty() || !ajouts.empty() || anticipation
+                       || !point_reprise.empty() || !hors_memoire.empty() || flux || couches
+                       || composantes || !sortie.empty()))
+        args_ok = false;
+    // Renumérotation : le résultat binaire serait écrit dans le nouvel ordre
+    if (!ordre.empty() && !sortie.empty())
+        args_ok = false;
+
+    if (!args_ok) {
+        if (pid == 0) {
+            cout << "Usage : mpirun -np <P> ./main fichier.dot [num_threads] [--anticipation]"
+                 << " [--bloc NB] [--grille PRxPC] [--distribue] [--moteur auto|dense|creux]"
+                 << " [--poids auto|int16|int32|int64|float] [--chemin A B]"
+                 << " [--semi-anneau min-plus|max-min|booleen] [--ajout A B W]... [--ecrire-csr F]"
+                 << " [--point-reprise F N [--reprendre]] [--hors-memoire F MO]"
+                 << " [--silencieux] [--sortie F] [--profil] [--profil-rangs F] [--flux]"
+                 << " [--couches C] [--symetrique] [--composantes] [--ordre rcm|medoides]" << endl;
+            cout << endl;
+            cout << "Paramètres:" << endl;
+            cout << "  <P>           : Nombre de processus MPI (quelconque)" << endl;
+            cout << "  fichier.dot   : Graphe au format DOT, liste d'arêtes \"u v poids\" ou binaire .gcsr" << endl;
+            cout << "  [num_threads] : Threads OpenMP par processus (défaut: 4)" << endl;
+            cout << "  --anticipation: Diffusion anticipée des panneaux k+1 (MPI_Ibcast)" << endl;
+            cout << "  --bloc NB     : Taille des blocs (défaut: min(256, n / max(PR,PC)))" << endl;
+            cout << "  --grille PRxPC: Grille de processus, PR*PC = P (défaut: MPI_Dims_create)" << endl;
+            cout << "  --distribue   : Blocs construits depuis les arêtes, aucune matrice n x n" << endl;
+            cout << "                  sur le root (pas de référence séquentielle ni d'affichage)" << endl;
+            cout << "  --moteur M    : dense = Floyd par blocs, creux = Dijkstra multi-sources," << endl;
+            cout << "                  auto = creux si densité < " << FLOYD_DENSITE_CREUX << " (défaut)" << endl;
+            cout << "  --poids TYPE  : Type des poids du calcul dense ; auto = plus petit entier" << endl;
+            cout << "                  contenant poids_max * (n-1) (défaut) ; un entier plus petit" << endl;
+            cout << "                  est refusé" << endl;
+            cout << "  --chemin A B  : Plus court chemin du sommet A au sommet B (successeurs" << endl;
+            cout << "                  distribués, moteur dense)" << endl;
+            cout << "  --semi-anneau S: min-plus = plus courts chemins (défaut), max-min = chemins" << endl;
+            cout << "                  de goulot, booleen = fermeture transitive (moteur dense," << endl;
+            cout << "                  sans --distribue ni --chemin)" << endl;
+            cout << "  --ajout A B W : Après le calcul, insère l'arête A -- B de poids W > 0 en O(n²)" << endl;
+            cout << "                  (répétable ; un sommet inconnu est ajouté au graphe)" << endl;
+            cout << "  --ecrire-csr F: Écrit le graphe lu au format binaire .gcsr (relu par mmap)" << endl;
+            cout << "  --point-reprise F N: Écrit l'état des blocs dans F (MPI-IO) toutes les N" << endl;
+            cout << "                  étapes K (moteur dense)" << endl;
+            cout << "  --reprendre   : Repart du point de reprise F s'il est compatible (même" << endl;
+            cout << "                  graphe, --bloc, --grille et type de poids)" << endl;
+            cout << "  --hors-memoire F MO: Blocs dans le fichier F, MO Mo de blocs en mémoire" << endl;
+            cout << "                  par processus (implique --distribue, moteur dense)" << endl;
+            cout << "  --silencieux  : Production : ni matrices affichées ni référence séquentielle," << endl;
+            cout << "                  le résultat reste distribué (résumé des distances)" << endl;
+            cout << "  --sortie F    : Écrit la matrice résultat dans F (binaire, MPI-IO collectif," << endl;
+            cout << "                  sans rassemblement sur le root)" << endl;
+            cout << "  --profil      : Temps des phases (panneaux, diffusion, reste, attente à la" << endl;
+            cout << "                  barrière) : min / moyenne / max / déséquilibre sur les" << endl;
+            cout << "                  processus (moteur dense)" << endl;
+            cout << "  --profil-rangs F: --profil, et temps de chaque processus à chaque étape K" << endl;
+            cout << "                  dans le fichier CSV F" << endl;
+            cout << "  --flux        : Tâches par bloc lancées dès réception de leurs entrées," << endl;
+            cout << "                  messages point à point, aucune collective (moteur dense," << endl;
+            cout << "                  sans --chemin, --anticipation ni --point-reprise)" << endl;
+            cout << "  --couches C   : Fermeture 2.5D : C copies de la matrice sur C couches de P/C" << endl;
+            cout << "                  processus, produits de Kleene partagés entre les couches" << endl;
+            cout << "                  (moteur dense, sans --chemin, --anticipation, --flux ni" << endl;
+            cout << "                  --point-reprise ; C divise P)" << endl;
+            cout << "  --symetrique  : Graphe non orienté : seuls les blocs du triangle supérieur" << endl;
+            cout << "                  sont stockés et mis à jour (min-plus ou max-min, sans" << endl;
+            cout << "                  --chemin, --ajout, --anticipation, --flux, --couches," << endl;
+            cout << "                  --point-reprise ni --sortie)" << endl;
+            cout << "  --composantes : Plus courts chemins par composante connexe : grandes" << endl;
+            cout << "                  composantes sur la grille, petites regroupées par processus" << endl;
+            cout << "                  (min-plus, sans --chemin, --ajout, --point-reprise, --profil" << endl;
+            cout << "                  ni --sortie)" << endl;
+            cout << "  --ordre O     : Renumérote les sommets avant la distribution des blocs :" << endl;
+            cout << "                  rcm = Cuthill-McKee inverse, medoides = groupes autour de" << endl;
+            cout << "                  germes éloignés (moteur dense, sans --sortie)" << endl;
+            cout << endl;
+            cout << "Exemples:" << endl;
+            cout << "  mpirun -np 4 ./main Exemple2.dot" << endl;
+            cout << "  mpirun -np 4 ./main Exemple2.dot 2" << endl;
+            cout << "  mpirun -np 4 ./main Exemple2.dot 2 --anticipation" << endl;
+            cout << "  mpirun -np 6 ./main Exemple2.dot 2 --grille 2x3 --bloc 64" << endl;
+            cout << "  mpirun -np 16 ./main grand.gcsr 4 --silencieux --sortie distances.bin" << endl;
+        }
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+    
+    // Configuration OpenMP
+    if(num_threads > 0){
+        omp_set_num_threads(num_threads);
+    }
+
+    Execution e;
+    e.pid = pid;
+    e.nprocs = nprocs;
+    e.num_threads = num_threads;
+    e.anticipation = anticipation;
+    e.distribue = distribue;
+    e.chemin_de = chemin_de;
+    e.chemin_vers = chemin_vers;
+    e.semi_anneau = semi_anneau;
+    e.ajouts = ajouts;
+    e.point_reprise = point_reprise;
+    e.intervalle_reprise = intervalle_reprise;
+    e.reprendre = reprendre;
+    e.hors_memoire = hors_memoire;
+    e.memoire = memoire;
+    e.silencieux = silencieux;
+    e.sortie = sortie;
+    e.profil = profil;
+    e.flux = flux;
+    e.couches = couches;
+    e.symetrique = symetrique;
+    e.composantes = composantes;
+    e.ordre = ordre;
+    e.profil_rangs = profil_rangs;
+    e.nb = nb;
+    e.pr = pr;
+    e.pc = pc;
+    e.nb_nodes = 0;
+    e.mat_adjacence = nullptr;
+
+    if (pid == 0) {
+        cout << "╔═══════════════════════════════════════════════════════════╗" << endl;
+        cout << "║     FLOYD-WARSHALL HYBRIDE MPI+OPENMP                     ║" << endl;
+        cout << "╚═══════════════════════════════════════════════════════════╝" << endl;
+        cout << endl;
+        cout << "Configuration:" << endl;
+        cout << "  Fichier       : " << file_name << endl;
+        cout << "  Processus MPI : " << nprocs << endl;
+        cout << "  Threads/proc  : " << (num_threads > 0 ? to_string(num_threads) : "auto") 
+             << " (max: " << omp_get_max_threads() << ")" << endl;
+        cout << "  Total workers : " << nprocs * omp_get_max_threads() << endl;
+        cout << "  Niveau thread : " << provided;
+        if(provided >= MPI_THREAD_FUNNELED) cout << " ✓";
+        cout << endl << endl;
+    }
+
+    // Lecture du graphe sur le root
+    long poids_max = 0;
+    double t_lecture = MPI_Wtime();
+    if (pid == 0 && distribue) {
+        e.aretes = lectureAretes(file_name, &e.nb_nodes, &e.my_nodes);
+        if (e.nb_nodes < 0) {
+            cerr << "Erreur : impossible de lire le graphe !" << endl;
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        cout << "=== Graphe : " << e.nb_nodes << " noeuds, " << e.aretes.size()/3
+             << " arêtes (mode distribué), lu en " << MPI_Wtime() - t_lecture
+             << " sec ===" << endl << endl;
+        for (size_t a = 2; a < e.aretes.size(); a += 3)
+            poids_max = max(poids_max, labs(e.aretes[a]));
+        if ((moteur != "dense" || composantes || !ordre.empty()) && !csrDepuisFichier(file_name, &e.csr))
+            e.csr = csrDepuisAretes(e.nb_nodes, e.aretes.data(), (long)e.aretes.size()/3);
+    } else if (pid == 0) {
+        e.mat_adjacence = lectureGraphe(file_name, &e.nb_nodes, &e.my_nodes);
+        if (!e.mat_adjacence) {
+            cerr << "Erreur : impossible de lire le graphe !" << endl;
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+
+        cout << "=== Graphe : " << e.nb_nodes << " noeuds, lu en " << MPI_Wtime() - t_lecture
+             << " sec ===" << endl;
+        if (!silencieux) {
+            cout << "=== Matrice d'adjacence ===" << endl;
+            affichage(e.mat_adjacence, e.nb_nodes, e.nb_nodes, 2);
+            cout << endl;
+        }
+
+        for (long x = 0; x < (long)e.nb_nodes * e.nb_nodes; x++)
+            poids_max = max(poids_max, labs(e.mat_adjacence[x]));
+        if ((moteur != "dense" || composantes || !ordre.empty()) && !csrDepuisFichier(file_name, &e.csr))
+            e.csr = csrDepuisMatrice(e.nb_nodes, e.mat_adjacence);
+    }
+
+    // Conversion du graphe lu au format binaire .gcsr
+    if (pid == 0 && !ecrire_csr.empty()) {
+        GrapheCSR g = !e.csr.debut.empty() ? e.csr
+                    : distribue ? csrDepuisAretes(e.nb_nodes, e.aretes.data(), (long)e.aretes.size()/3)
+                    : csrDepuisMatrice(e.nb_nodes, e.mat_adjacence);
+        vector<string> noms(e.nb_nodes);
+        for (auto& x : e.my_nodes) noms[x.second] = x.first;
+        if (ecrireCSR(ecrire_csr.c_str(), g.n, g.debut.data(), g.voisins.data(), g.poids.data(), noms) == 0)
+            cout << "=== Graphe écrit dans " << ecrire_csr << " (" << g.voisins.size() << " arcs) ===" << endl << endl;
+        else
+            cerr << "Erreur : impossible d'écrire " << ecrire_csr << endl;
+    }
+
+    // Diffusion du nombre de noeuds à tous les processus
+    MPI_Bcast(&e.nb_nodes, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    // Choix du moteur : Dijkstra multi-sources sur les graphes creux.
+    // Les chemins, les points de reprise, le profil, le flot de données, la
+    // fermeture 2.5D, le mode symétrique et les composantes ne concernent que
+    // le moteur dense.
+    bool chemin = !chemin_de.empty();
+    e.creux = 0;
+    if (pid == 0)
+        e.creux = !chemin && ajouts.empty() && point_reprise.empty() && hors_memoire.empty() && !profil && !flux
+                  && !couches && !symetrique
+                  && !composantes
+                  && semi_anneau == "min-plus"
+                  && ((moteur == "creux") || (moteur == "auto" && grapheCreux(e.csr)));
+    if (pid == 0 && e.creux && poidsNegatifs(e.csr)) {
+        // Le choix automatique l'écarte déjà ; imposé, Dijkstra serait faux
+        cerr << "Erreur : --moteur creux (Dijkstra) exige des poids positifs ou nuls" << endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_Bcast(&e.creux, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    // Type des poids : le plus petit qui représente toutes les distances
+    int type = POIDS_INT32;
+    if (pid == 0 && !e.creux) {
+        // Les arêtes de --ajout (et leurs nouveaux sommets) comptent aussi
+        for (size_t a = 2; a < ajouts.size(); a += 3)
+            poids_max = max(poids_max, stol(ajouts[a]));
+        if (poids == "auto") type = choisirTypePoids(poids_max, e.nb_nodes + (int)ajouts.size()/3);
+        else if (poids == "int16") type = POIDS_INT16;
+        else if (poids == "int64") type = POIDS_INT64;
+        else if (poids == "float") type = POIDS_FLOAT;
+        // Un type imposé trop étroit ferait déborder les poids ou les distances
+        int n_max = e.nb_nodes + (int)ajouts.size()/3;
+        if (!typePoidsSuffit((TypePoids)type, poids_max, n_max)) {
+            cerr << "Erreur : --poids " << poids << " ne peut représenter les distances (poids max "
+                 << poids_max << ", " << n_max << " noeuds) ; type minimal : "
+                 << nomTypePoids(choisirTypePoids(poids_max, n_max)) << endl;
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        if (type == POIDS_FLOAT && borneDistances(poids_max, n_max) >= (double)(1 << 24))
+            cerr << "Attention : distances au-delà de 2^24, arrondies en float" << endl;
+    }
+    MPI_Bcast(&type, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    if (pid == 0) {
+        cout << "=== Poids : " << nomTypePoids((TypePoids)type)
+             << (poids == "auto" && !e.creux ? " (auto, poids max " + to_string(poids_max) + ")" : "")
+             << ", noyau (min,+) ";
+        switch (type) {
+            case POIDS_INT16: cout << minPlusJeu<int16_t>(); break;
+            case POIDS_INT64: cout << minPlusJeu<int64_t>(); break;
+            case POIDS_FLOAT: cout << minPlusJeu<float>(); break;
+            default:          cout << minPlusJeu<int32_t>(); break;
+        }
+        cout << " ===" << endl << endl;
+    }
+
+    switch (type) {
+        case POIDS_INT16: calculer<int16_t>(e); break;
+        case POIDS_INT64: calculer<int64_t>(e); break;
+        case POIDS_FLOAT: calculer<float>(e); break;
+        default:          calculer<int32_t>(e); break;
+    }
+
     MPI_Finalize();
     return 0;
 }
@@ -0,0 +1,296 @@
+#include <mpi.h>
+#include <omp.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "ForGraph.hpp"
+#include "FoydPar.hpp"
+#include "MinPlus.hpp"
+#include "Generateurs.hpp"
+using namespace std;
+
+/*
+ * Banc d'essai de Floyd-Warshall : graphes synthétiques générés en mémoire,
+ * référence séquentielle (floydTuiles) pour vérifier les distances, puis
+ * Floyd par blocs sur la grille de tous les processus pour chaque nombre de
+ * threads demandé. Les efficacités se rapportent au même moteur par blocs
+ * sur 1 processus et 1 thread (même noyau, mêmes tuiles sautées). Une ligne
+ * JSON par mesure est ajoutée au fichier de sortie ; make bench enchaîne
+ * les nombres de processus.
+ */
+
+/* Liste d'entiers ou de mots séparés par des virgules */
+static vector<string> decouper(const string& s) {
+    vector<string> v;
+    stringstream ss(s);
+    string x;
+    while (getline(ss, x, ',')) if (!x.empty()) v.push_back(x);
+    return v;
+}
+
+/* Somme des distances finies (contrôle de cohérence entre les moteurs) */
+static long long sommeDistances(const int* v, long len) {
+    long long s = 0;
+    for (long x = 0; x < len; x++)
+        if (v[x] < Poids<int>::infini()) s += v[x];
+    return s;
+}
+
+/* Nombre JSON (null si la mesure n'existe pas) */
+static string nombre(double x) {
+    if (!(x >= 0) || std::isinf(x)) return "null";
+    ostringstream o;
+    o << setprecision(6) << x;
+    return o.str();
+}
+
+/* Une mesure : moteur, configuration, temps */
+struct Mesure {
+    string famille, moteur;
+    int n;
+    long aretes;
+    int processus, threads, pr, pc, nb;
+    double temps;                 // calcul seul (max sur les processus)
+    double distribution;          // répartition des arêtes vers les blocs
+    TempsPhases phases;           // max sur les processus
+    double efficacite_forte;      // t_blocs(n, P=T=1) / (P * t * temps), < 0 si inconnue
+    double efficacite_faible;     // t_blocs(n0, P=T=1) / temps à travail par worker constant
+    int verifie;                  // -1 : pas de référence, 0 : écart, 1 : identique
+};
+
+static void ecrireMesure(ostream& out, const Mesure& m) {
+    double maj = (double)m.n * m.n * m.n / m.temps;
+    out << "{\"famille\":\"" << m.famille << "\",\"moteur\":\"" << m.moteur << "\""
+        << ",\"n\":" << m.n << ",\"aretes\":" << m.aretes
+        << ",\"processus\":" << m.processus << ",\"threads\":" << m.threads
+        << ",\"grille\":\"" << m.pr << "x" << m.pc << "\",\"bloc\":" << m.nb
+        << ",\"temps\":" << nombre(m.temps)
+        << ",\"phases\":{\"distribution\":" << nombre(m.distribution)
+        << ",\"panneaux\":" << nombre(m.phases.panneaux)
+        << ",\"diffusion\":" << nombre(m.phases.diffusion)
+        << ",\"reste\":" << nombre(m.phases.reste) << "}"
+        << ",\"maj_min_plus_par_sec\":" << nombre(maj)
+        << ",\"efficacite_forte\":" << nombre(m.efficacite_forte)
+        << ",\"efficacite_faible\":" << nombre(m.efficacite_faible)
+        << ",\"verifie\":" << (m.verifie < 0 ? "null" : m.verifie ? "true" : "false")
+        << "}" << endl;
+}
+
+/* Floyd séquentiel par tuiles sur le root ; rend le temps et la somme des distances */
+static double referenceSequentielle(const vector<int>& aretes, int n, long long* somme) {
+    int* adj = new int[(long)n * n]();
+    for (size_t e = 0; e + 2 < aretes.size(); e += 3)
+        if (aretes[e] != aretes[e+1]) {
+            adj[(long)aretes[e] * n + aretes[e+1]] = aretes[e+2];
+            adj[(long)aretes[e+1] * n + aretes[e]] = aretes[e+2];
+        }
+    int* D = InitDk<int>(n, adj);
+    delete[] adj;
+    double t0 = MPI_Wtime();
+    floydTuiles(D, n, nullptr, FLOYD_TUILE);
+    double t = MPI_Wtime() - t0;
+    *somme = sommeDistances(D, (long)n * n);
+    delete[] D;
+    return t;
+}
+
+/* Floyd par blocs seul sur le root (MPI_COMM_SELF, 1 thread), blocs de
+ * taille nb (0 = automatique) ; rend le meilleur temps sur les répétitions */
+static double referenceBlocs(const vector<int>& aretes, int n, int nb, int repetitions, int* nb_ref) {
+    Distribution d = creerDistribution(n, nb, 1, 1, MPI_COMM_SELF);
+    int* D = new int[tailleLocale(d)];
+    double t = 1e300;
+    for (int rep = 0; rep < repetitions; rep++) {
+        distribuerAretes(aretes.data(), (long)aretes.size() / 3, D, d, 0);
+        double t0 = MPI_Wtime();
+        floydBlocsLocal(D, d, 1);
+        t = min(t, MPI_Wtime() - t0);
+    }
+    *nb_ref = d.nb;
+    delete[] D;
+    libererDistribution(d);
+    return t;
+}
+
+int main(int argc, char* argv[]) {
+    int pid, nprocs, provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    vector<string> tailles = {"1024", "2048"};
+    vector<string> familles = {"aleatoire", "grille", "geometrique", "epsilon"};
+    vector<string> threads = {"1"};
+    int degre = 8, poids_max = 100, nb = 0, repetitions = 1, n_faible = 0;
+    int sequentiel_max = 4096;
+    unsigned graine = 1;
+    string sortie = "bench.jsonl";
+    bool args_ok = true;
+    for (int a = 1; a < argc && args_ok; a++) {
+        string arg = argv[a];
+        bool val = (a+1 < argc);
+        if (arg == "--tailles" && val) tailles = decouper(argv[++a]);
+        else if (arg == "--familles" && val) familles = decouper(argv[++a]);
+        else if (arg == "--threads" && val) threads = decouper(argv[++a]);
+        else if (arg == "--degre" && val) degre = atoi(argv[++a]);
+        else if (arg == "--bloc" && val) nb = atoi(argv[++a]);
+        else if (arg == "--repetitions" && val) repetitions = max(1, atoi(argv[++a]));
+        else if (arg == "--sequentiel-max" && val) sequentiel_max = atoi(argv[++a]);
+        else if (arg == "--faible" && val) n_faible = atoi(argv[++a]);
+        else if (arg == "--graine" && val) graine = (unsigned)atoi(argv[++a]);
+        else if (arg == "--sortie" && val) sortie = argv[++a];
+        else args_ok = false;
+    }
+    FamilleGraphe f;
+    for (const string& x : familles) args_ok = args_ok && familleDepuisNom(x, &f);
+    for (const string& x : tailles) args_ok = args_ok && atoi(x.c_str()) > 1;
+    for (const string& x : threads) args_ok = args_ok && atoi(x.c_str()) > 0;
+
+    if (!args_ok) {
+        if (pid == 0) {
+            cout << "Usage : mpirun -np <P> ./bench_floyd [--tailles N1,N2,...] [--familles F1,...]"
+                 << " [--threads T1,...] [--degre D] [--bloc NB] [--repetitions R]"
+                 << " [--sequentiel-max N] [--faible N0] [--graine G] [--sortie F]" << endl << endl;
+            cout << "  --tailles       : Nombres de sommets (défaut 1024,2048)" << endl;
+            cout << "  --familles      : aleatoire, grille, geometrique, epsilon (défaut : toutes)" << endl;
+            cout << "  --threads       : Threads OpenMP par processus à mesurer (défaut 1)" << endl;
+            cout << "  --degre         : Degré moyen (seuil de Hamming pour epsilon, défaut 8)" << endl;
+            cout << "  --repetitions   : Mesures par configuration, la plus rapide est gardée" << endl;
+            cout << "  --sequentiel-max: Taille maximale de la référence séquentielle (défaut 4096)" << endl;
+            cout << "  --faible N0     : Mise à l'échelle faible : n = N0 * (P*T)^(1/3) remplace --tailles" << endl;
+            cout << "  --sortie        : Fichier JSON, une mesure par ligne, complété (défaut bench.jsonl)" << endl;
+        }
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+
+    ofstream out;
+    if (pid == 0) {
+        out.open(sortie, ios::app);
+        cout << "famille      moteur         n      P  T   temps (s)    maj/s      eff.forte eff.faible" << endl;
+    }
+    // Moteur mesuré : Floyd par blocs (floydBlocsLocal) et son noyau (min,+)
+    const string moteur = string("blocs-") + minPlusJeu<int>();
+
+    for (const string& nom : familles) {
+        familleDepuisNom(nom, &f);
+        // Référence de la mise à l'échelle faible : les blocs sur N0, P = T = 1
+        double t_faible = -1;
+        if (n_faible > 0 && n_faible <= sequentiel_max && pid == 0) {
+            int nb_ref;
+            vector<int> aretes = genererGraphe(f, n_faible, degre, poids_max, graine);
+            t_faible = referenceBlocs(aretes, n_faible, nb, repetitions, &nb_ref);
+            Mesure r = {nom, moteur, n_faible, (long)aretes.size() / 3, 1, 1, 1, 1, nb_ref,
+                        t_faible, 0, TempsPhases(), -1, 1, -1};
+            ecrireMesure(out, r);
+        }
+
+        // Tailles mesurées : liste fixe (forte) ou une par nombre de threads (faible)
+        vector<pair<int, int> > configs; // (n, threads) ; threads 0 = tous
+        if (n_faible > 0)
+            for (const string& t : threads)
+                configs.push_back(make_pair((int)lround(n_faible * cbrt((double)nprocs * atoi(t.c_str()))),
+                                            atoi(t.c_str())));
+        else
+            for (const string& x : tailles) configs.push_back(make_pair(atoi(x.c_str()), 0));
+
+        for (auto& c : configs) {
+            int n = c.first;
+            vector<int> aretes;
+            long m = 0;
+            if (pid == 0) {
+                aretes = genererGraphe(f, n, degre, poids_max, graine);
+                m = (long)aretes.size() / 3;
+            }
+
+            // Référence séquentielle (distances attendues) et référence des
+            // efficacités : le même moteur par blocs sur 1 processus, 1 thread
+            Distribution dist = creerDistribution(n, nb, 0, 0);
+            double t_ref = -1;
+            long long somme_seq = 0;
+            if (pid == 0 && n <= sequentiel_max) {
+                double t_seq = referenceSequentielle(aretes, n, &somme_seq);
+                Mesure s = {nom, "tuiles", n, m, 1, 1, 1, 1, FLOYD_TUILE, t_seq, 0, TempsPhases(), -1, -1, -1};
+                ecrireMesure(out, s);
+                printf("%-12s %-12s %6d %3d %2d %11.4f %10.3g\n", nom.c_str(), "tuiles", n, 1, 1,
+                       t_seq, (double)n*n*n / t_seq);
+                int nb_ref;
+                t_ref = referenceBlocs(aretes, n, dist.nb, repetitions, &nb_ref);
+                if (nprocs > 1) {
+                    // Avec un seul processus, la boucle ci-dessous mesure déjà P = T = 1
+                    Mesure b = {nom, moteur, n, m, 1, 1, 1, 1, nb_ref, t_ref, 0, TempsPhases(), 1, -1, -1};
+                    ecrireMesure(out, b);
+                    printf("%-12s %-12s %6d %3d %2d %11.4f %10.3g %9s\n", nom.c_str(), moteur.c_str(), n, 1, 1,
+                           t_ref, (double)n*n*n / t_ref, nombre(1).c_str());
+                }
+            }
+            int* D_local = new int[tailleLocale(dist)];
+            for (const string& tt : threads) {
+                int t = atoi(tt.c_str());
+                if (c.second && t != c.second) continue;
+                Mesure r = {nom, moteur, n, m, nprocs, t, dist.g.pr, dist.g.pc,
+                            dist.nb, 1e300, 0, TempsPhases(), -1, -1, -1};
+                for (int rep = 0; rep < repetitions; rep++) {
+                    MPI_Barrier(MPI_COMM_WORLD);
+                    double t0 = MPI_Wtime();
+                    distribuerAretes(aretes.data(), m, D_local, dist, 0);
+                    double t_dist = MPI_Wtime() - t0;
+
+                    TempsPhases ph{};
+                    MPI_Barrier(MPI_COMM_WORLD);
+                    t0 = MPI_Wtime();
+                    floydBlocsLocal(D_local, dist, t, false, nullptr, nullptr, &ph);
+                    double t_calc = MPI_Wtime() - t0;
+
+                    double v[5] = {t_calc, t_dist, ph.panneaux, ph.diffusion, ph.reste}, v_max[5];
+                    MPI_Allreduce(v, v_max, 5, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+                    if (v_max[0] < r.temps) {
+                        r.temps = v_max[0];
+                        r.distribution = v_max[1];
+                        r.phases.panneaux = v_max[2];
+                        r.phases.diffusion = v_max[3];
+                        r.phases.reste = v_max[4];
+                    }
+                }
+
+                // Contrôle : même somme des distances que la référence
+                long long somme = 0, somme_tot = 0;
+                for (int li = 0; li < dist.lignes; li++)
+                    for (int lj = 0; lj < dist.colonnes; lj++) {
+                        int i0 = blocGlobalLigne(dist, li) * dist.nb, j0 = blocGlobalColonne(dist, lj) * dist.nb;
+                        const int* B = blocLocal(D_local, dist, li, lj);
+                        for (int i = 0; i < dist.nb && i0 + i < n; i++)
+                            somme += sommeDistances(B + (long)i * dist.nb, max(0, min(dist.nb, n - j0)));
+                    }
+                MPI_Reduce(&somme, &somme_tot, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+                if (pid == 0) {
+                    if (t_ref > 0) {
+                        r.efficacite_forte = t_ref / ((double)nprocs * t * r.temps);
+                        r.verifie = (somme_tot == somme_seq);
+                    }
+                    if (n_faible > 0 && t_faible > 0)
+                        r.efficacite_faible = t_faible / r.temps;
+                    ecrireMesure(out, r);
+                    printf("%-12s %-12s %6d %3d %2d %11.4f %10.3g %9s %9s%s\n", nom.c_str(), r.moteur.c_str(),
+                           n, nprocs, t, r.temps, (double)n*n*n / r.temps,
+                           nombre(r.efficacite_forte).c_str(), nombre(r.efficacite_faible).c_str(),
+                           r.verifie == 0 ? "  ÉCART" : "");
+                    fflush(stdout);
+                }
+            }
+            delete[] D_local;
+            libererDistribution(dist);
+        }
+    }
+
+    if (pid == 0)
+        cout << "Mesures ajoutées à " << sortie << endl;
+    MPI_Finalize();
+    return 0;
+}
@@ -1,5 +1,5 @@
 // main_pam.cpp
-// Simple driver to run PAM. It can construct distance matrix from a .dot via existing Floyd code (requires Graphviz)
+// Simple driver to run PAM. It can construct distance matrix from a .dot via existing Floyd code (native reader, Graphviz optional)
 
 #include <iostream>
 #include <vector>
@@ -12,7 +12,7 @@
 
 #include "PAM.hpp"
 
-#ifdef WITH_GRAPHVIZ
+#ifdef LECTURE_GRAPHE
 #include "../Floyd/ForGraph.hpp"
 #endif
 
@@ -46,10 +46,10 @@ int main(int argc, char* argv[]) {
     vector<int> D;
 
     // Two input modes:
-    // - WITH_GRAPHVIZ defined at compile time: read .dot file and use Floyd code (Graphviz required)
+    // - LECTURE_GRAPHE defined at compile time: read .dot / edge list file and use Floyd code
     // - otherwise: input is a distance matrix text file: first line n, then n lines with n ints
     if (rank == 0) {
-        #ifdef WITH_GRAPHVIZ
+        #ifdef LECTURE_GRAPHE
                 map<string,int> nodes;
                 int* mat_adj = lectureGraphe(dotfile, &n, &nodes);
                 if (!mat_adj) {
@@ -16,7 +16,7 @@
 
 #include "PAM.hpp"
 
-#ifdef WITH_GRAPHVIZ
+#ifdef LECTURE_GRAPHE
 #include "../Floyd/ForGraph.hpp"
 #endif
 
@@ -76,7 +76,7 @@ int main(int argc, char* argv[]) {
     vector<int> D;
 
     if (rank == 0) {
-        #ifdef WITH_GRAPHVIZ
+        #ifdef LECTURE_GRAPHE
             map<string,int> nodes;
             int* mat_adj = lectureGraphe(dotfile, &n, &nodes);
             if (!mat_adj) {